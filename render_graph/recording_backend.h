@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../src/core/recording_backend.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../src/core/simulator_backend.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/attachment_ops_test.h"
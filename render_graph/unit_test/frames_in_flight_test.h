@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/frames_in_flight_test.h"
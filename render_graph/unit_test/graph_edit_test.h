@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/graph_edit_test.h"
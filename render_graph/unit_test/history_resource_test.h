@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/history_resource_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/imported_rebind_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/job_system_test.h"
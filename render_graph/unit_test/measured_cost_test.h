@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/measured_cost_test.h"
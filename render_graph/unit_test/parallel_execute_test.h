@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/parallel_execute_test.h"
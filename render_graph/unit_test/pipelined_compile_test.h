@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/pipelined_compile_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/recording_backend_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/retained_mode_test.h"
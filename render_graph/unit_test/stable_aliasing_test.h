@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/stable_aliasing_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/streaming_execution_test.h"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/test_resources.h"
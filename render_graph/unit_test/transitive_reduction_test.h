@@ -0,0 +1,3 @@
+#pragma once
+
+#include "../../src/unit_test/transitive_reduction_test.h"
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 #include <vector>
 
 #include "barrier.h"
@@ -21,13 +22,25 @@ namespace render_graph
 
         // Called after render_graph_system::compile() finishes allocation/aliasing.
         // Backend may create transient physical resources based on the representative logical metas.
+        // Also called by compile_variant() cache hits and swap_plans(), while up to frames_in_flight earlier frames
+        // may still be on the GPU. A native object the new plan no longer uses at the same slot must not be
+        // destroyed or handed to another slot yet: it is retired and freed only after frames_in_flight further
+        // on_begin_frame() calls. The caller waits for a frame's fence before calling on_begin_frame() for it.
         virtual void on_compile_resource_allocation(const resource_meta_table& /*meta*/,
                                                     const physical_resource_meta& /*physical_meta*/)
         {
         }
 
+        // Called after compile() derives per-pass attachment load/store ops.
+        // Backends that begin render passes/dynamic rendering use these instead of LOAD/STORE everywhere.
+        virtual void on_compile_attachment_ops(const per_pass_attachment& /*plan*/)
+        {
+        }
+
         // Imported bindings (swapchain/backbuffer, externally owned resources).
         // Backends may defer binding until allocation mapping is known.
+        // After compile(), rebinding an imported handle (e.g. the next swapchain image) must only
+        // patch the backend's physical table slot; the compiled plan stays valid, no recompile needed.
         virtual void bind_imported_image(resource_handle /*logical_image*/,
                                          native_handle /*native_image*/,
                                          native_handle /*native_view*/ = 0)
@@ -43,7 +56,25 @@ namespace render_graph
         // Concrete backends implement lowering to API-specific synchronization primitives.
         // (Declared in barrier.h / plan types to avoid including any graphics API headers here.)
 
+        // Called by render_graph_system::execute() before the first pass of a frame.
+        // frame_in_flight is in [0, frames_in_flight); backends use it to resolve physical ids to per-frame slots.
+        // The GPU has finished the frame that last used this frame_in_flight (the caller waited for its fence), so
+        // backends also free the objects retired frames_in_flight calls ago here.
+        virtual void on_begin_frame(uint32_t /*frame_in_flight*/)
+        {
+        }
+
         // Apply all barriers that must happen before executing this pass.
         virtual void apply_barriers(pass_handle pass, const per_pass_barrier& plan) = 0;
+
+        // Called by execute() right before and after a pass's execute function (after apply_barriers).
+        // name is the pass name (render_graph_system::set_pass_name), empty if unnamed.
+        virtual void on_pass_begin(pass_handle /*pass*/, std::string_view /*name*/)
+        {
+        }
+
+        virtual void on_pass_end(pass_handle /*pass*/)
+        {
+        }
     };
 }
@@ -50,6 +50,7 @@ namespace render_graph
 
         // The physical resource id (after aliasing); index into backend/user-side physical tables.
         // NOTE: This is NOT an API object handle; it's an RG-defined id.
+        // With frames in flight, resolve it to the current frame's slot (physical_resource_meta::resolve_*_slot).
         resource_handle physical = 0;
 
         pipeline_domain src_domain = pipeline_domain::any;
@@ -65,6 +66,10 @@ namespace render_graph
 
         // For aliasing barrier: previous logical resource sharing the same physical id.
         resource_handle prev_logical = 0;
+
+        // True if the op targets the previous frame's slot of a history resource (read_*_previous_frame);
+        // resolve it with physical_resource_meta::resolve_*_history_slot.
+        bool previous_frame = false;
     };
 
     struct per_pass_barrier
@@ -93,6 +98,8 @@ namespace render_graph
         
         std::vector<resource_handle> prev_logicals;
 
+        std::vector<bool> previous_frames;
+
         void clear()
         {
             pass_begins.clear();
@@ -108,6 +115,7 @@ namespace render_graph
             src_usage_bits.clear();
             dst_usage_bits.clear();
             prev_logicals.clear();
+            previous_frames.clear();
         }
 
         void resize_passes(size_t pass_count)
@@ -129,6 +137,67 @@ namespace render_graph
             src_usage_bits.resize(op_count);
             dst_usage_bits.resize(op_count);
             prev_logicals.resize(op_count);
+            previous_frames.resize(op_count);
+        }
+    };
+
+    // How an attachment's previous contents are treated when a pass begins.
+    // A write may cover only part of the image (scissored or blended overlay), so contents written by an earlier
+    // pass of the plan are loaded unless the pass declared a full overwrite (pass_setup_context::overwrite_image).
+    enum class attachment_load_op : uint8_t
+    {
+        load = 0,  // Read by the pass, or written by an earlier pass of the plan.
+        clear,     // First write of the resource in the plan; nothing to preserve.
+        dont_care, // Declared full overwrite that does not read the previous contents.
+    };
+
+    // Whether an attachment's contents must be written back when a pass ends.
+    enum class attachment_store_op : uint8_t
+    {
+        store = 0, // Used by a later pass, declared as output or imported.
+        dont_care, // Last use of the resource; contents can be discarded.
+    };
+
+    struct per_pass_attachment
+    {
+        // Per-pass ranges into the SoA arrays below (CSR style), same layout as per_pass_barrier.
+        // For pass p: attachments are in [pass_begins[p], pass_begins[p] + pass_lengths[p]).
+        std::vector<uint32_t> pass_begins;
+        std::vector<uint32_t> pass_lengths;
+
+        std::vector<resource_handle> logicals;
+        std::vector<resource_handle> physicals;
+
+        // image_usage bits of the attachment in this pass (COLOR_ATTACHMENT / DEPTH_STENCIL_ATTACHMENT).
+        std::vector<uint32_t> usage_bits;
+
+        std::vector<attachment_load_op> load_ops;
+        std::vector<attachment_store_op> store_ops;
+
+        void clear()
+        {
+            pass_begins.clear();
+            pass_lengths.clear();
+            logicals.clear();
+            physicals.clear();
+            usage_bits.clear();
+            load_ops.clear();
+            store_ops.clear();
+        }
+
+        void resize_passes(size_t pass_count)
+        {
+            pass_begins.assign(pass_count + 1, 0);
+            pass_lengths.assign(pass_count, 0);
+        }
+
+        void resize_ops(size_t op_count)
+        {
+            logicals.resize(op_count);
+            physicals.resize(op_count);
+            usage_bits.resize(op_count);
+            load_ops.resize(op_count);
+            store_ops.resize(op_count);
         }
     };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "backend.h"
+#include "profiler.h"
 
 #if !defined(_WIN32)
 #error "dx12_backend requires Windows (_WIN32)"
@@ -14,9 +15,10 @@
 #include <dxgi1_6.h>
 #include <wrl/client.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace render_graph
@@ -32,13 +34,42 @@ namespace render_graph
         std::vector<uint32_t> logical_to_physical_img_id;
         std::vector<uint32_t> logical_to_physical_buf_id;
 
-        // Physical tables (one entry per physical id)
+        // Physical tables (one entry per slot; see physical_resource_meta frames-in-flight replication)
         std::vector<ComPtr> images;
         std::vector<ComPtr> buffers;
 
-        // Pending imported bindings (logical -> native)
-        std::unordered_map<resource_handle, ID3D12Resource*> pending_imported_images;
-        std::unordered_map<resource_handle, ID3D12Resource*> pending_imported_buffers;
+        // Description and physical id each owned slot was created for. A compile keeps the resource of a slot
+        // whose physical id and description are unchanged and only creates or retires what differs.
+        std::vector<D3D12_RESOURCE_DESC> image_descs;
+        std::vector<uint32_t> image_physicals;
+        std::vector<D3D12_RESOURCE_DESC> buffer_descs;
+        std::vector<uint32_t> buffer_physicals;
+
+        // Resources a compile stopped using. Frames recorded before the compile may still be on the GPU, so the
+        // reference is only dropped by the on_begin_frame call numbered release_at
+        // (see backend::on_compile_resource_allocation).
+        struct retired_resource
+        {
+            ComPtr resource;
+            uint64_t release_at = 0;
+        };
+
+        uint64_t begun_frames = 0; // on_begin_frame calls so far
+        std::vector<retired_resource> retired_resources;
+
+        // Imported bindings (flat, indexed by logical handle; nullptr if unbound)
+        std::vector<ID3D12Resource*> imported_images;
+        std::vector<ID3D12Resource*> imported_buffers;
+
+        // True if the physical id is owned externally (filled at compile)
+        std::vector<bool> image_is_imported;
+        std::vector<bool> buffer_is_imported;
+
+        // Frames-in-flight slot mapping (filled at compile) and the frame being recorded.
+        uint32_t frames_in_flight = 1;
+        uint32_t current_frame = 0;
+        std::vector<uint32_t> physical_image_frame_slots;
+        std::vector<uint32_t> physical_buffer_frame_slots;
 
         void set_context(ID3D12Device* device_in)
         {
@@ -58,51 +89,81 @@ namespace render_graph
             }
         }
 
+        // Cheap enough to call every frame (e.g. after rotating the back buffer index):
+        // once compiled, the physical slot of the imported handle is patched in place.
         void bind_imported_image(resource_handle logical_image, native_handle native_image, native_handle /*native_view*/ = 0) override
         {
             // NOLINTNEXTLINE(performance-no-int-to-ptr)
             auto* res = reinterpret_cast<ID3D12Resource*>(native_image);
-            pending_imported_images[logical_image] = res;
+            if (logical_image >= imported_images.size())
+            {
+                imported_images.resize(static_cast<size_t>(logical_image) + 1, nullptr);
+            }
+            imported_images[logical_image] = res;
+
+            const auto physical_id = get_physical_image_id(logical_image);
+            if (physical_id < images.size() && image_is_imported[physical_id])
+            {
+                images[physical_id] = res; // AddRef
+            }
         }
 
         void bind_imported_buffer(resource_handle logical_buffer, native_handle native_buffer) override
         {
             // NOLINTNEXTLINE(performance-no-int-to-ptr)
             auto* res = reinterpret_cast<ID3D12Resource*>(native_buffer);
-            pending_imported_buffers[logical_buffer] = res;
+            if (logical_buffer >= imported_buffers.size())
+            {
+                imported_buffers.resize(static_cast<size_t>(logical_buffer) + 1, nullptr);
+            }
+            imported_buffers[logical_buffer] = res;
+
+            const auto physical_id = get_physical_buffer_id(logical_buffer);
+            if (physical_id < buffers.size() && buffer_is_imported[physical_id])
+            {
+                buffers[physical_id] = res;
+            }
         }
 
         void on_compile_resource_allocation(const resource_meta_table& meta, const physical_resource_meta& physical_meta) override
         {
+            RG_PROFILE_SCOPE("dx12_backend::allocate");
+
+            const auto previous_frames_in_flight = frames_in_flight;
             logical_to_physical_img_id = physical_meta.handle_to_physical_img_id;
             logical_to_physical_buf_id = physical_meta.handle_to_physical_buf_id;
+            frames_in_flight = physical_meta.frames_in_flight;
+            physical_image_frame_slots = physical_meta.physical_image_frame_slots;
+            physical_buffer_frame_slots = physical_meta.physical_buffer_frame_slots;
 
-            images.clear();
-            buffers.clear();
-            images.resize(physical_meta.physical_image_meta.size());
-            buffers.resize(physical_meta.physical_buffer_meta.size());
+            // One native object per slot; replicas of per-frame physical ids follow the physical ids.
+            const auto image_slot_count = std::max(physical_meta.image_slot_to_physical.size(), physical_meta.physical_image_meta.size());
+            const auto buffer_slot_count = std::max(physical_meta.buffer_slot_to_physical.size(), physical_meta.physical_buffer_meta.size());
 
-            if (!device)
+            // Imported slots only reference external objects; fill them even without a device.
+            // Imported physical ids are never replicated, so their slot is the physical id.
+            image_is_imported.assign(image_slot_count, false);
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
             {
-                return;
+                const auto rep = physical_meta.physical_image_meta[physical_id];
+                image_is_imported[physical_id] = rep < meta.image_metas.names.size() && meta.image_metas.is_imported[rep];
+            }
+            buffer_is_imported.assign(buffer_slot_count, false);
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            {
+                const auto rep = physical_meta.physical_buffer_meta[physical_id];
+                buffer_is_imported[physical_id] = rep < meta.buffer_metas.names.size() && meta.buffer_metas.is_imported[rep];
             }
 
-            // Images
-            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
+            // Describe every slot the backend owns (Dimension stays UNKNOWN for imported and empty slots).
+            std::vector<D3D12_RESOURCE_DESC> next_image_descs(image_slot_count, D3D12_RESOURCE_DESC{});
+            std::vector<uint32_t> next_image_physicals(image_slot_count, std::numeric_limits<uint32_t>::max());
+            for (size_t slot = 0; slot < image_slot_count; slot++)
             {
+                const auto physical_id = (slot < physical_meta.image_slot_to_physical.size()) ? physical_meta.image_slot_to_physical[slot] : slot;
                 const auto rep = physical_meta.physical_image_meta[physical_id];
-                if (rep >= meta.image_metas.names.size())
-                {
-                    continue;
-                }
-
-                if (meta.image_metas.is_imported[rep])
+                if (rep >= meta.image_metas.names.size() || image_is_imported[slot])
                 {
-                    auto it = pending_imported_images.find(rep);
-                    if (it != pending_imported_images.end() && it->second)
-                    {
-                        images[physical_id] = it->second; // AddRef
-                    }
                     continue;
                 }
 
@@ -137,43 +198,21 @@ namespace render_graph
                 desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
                 desc.Flags = flags;
 
-                D3D12_HEAP_PROPERTIES heap{};
-                heap.Type = D3D12_HEAP_TYPE_DEFAULT;
-
-                ComPtr resource;
-                const HRESULT hr = device->CreateCommittedResource(
-                    &heap,
-                    D3D12_HEAP_FLAG_NONE,
-                    &desc,
-                    D3D12_RESOURCE_STATE_COMMON,
-                    nullptr,
-                    IID_PPV_ARGS(resource.GetAddressOf()));
-
-                if (SUCCEEDED(hr))
-                {
-                    images[physical_id] = resource;
-                }
+                next_image_descs[slot] = desc;
+                next_image_physicals[slot] = static_cast<uint32_t>(physical_id);
             }
 
-            // Buffers
-            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            std::vector<D3D12_RESOURCE_DESC> next_buffer_descs(buffer_slot_count, D3D12_RESOURCE_DESC{});
+            std::vector<uint32_t> next_buffer_physicals(buffer_slot_count, std::numeric_limits<uint32_t>::max());
+            for (size_t slot = 0; slot < buffer_slot_count; slot++)
             {
+                const auto physical_id = (slot < physical_meta.buffer_slot_to_physical.size()) ? physical_meta.buffer_slot_to_physical[slot] : slot;
                 const auto rep = physical_meta.physical_buffer_meta[physical_id];
-                if (rep >= meta.buffer_metas.names.size())
+                if (rep >= meta.buffer_metas.names.size() || buffer_is_imported[slot])
                 {
                     continue;
                 }
 
-                if (meta.buffer_metas.is_imported[rep])
-                {
-                    auto it = pending_imported_buffers.find(rep);
-                    if (it != pending_imported_buffers.end() && it->second)
-                    {
-                        buffers[physical_id] = it->second;
-                    }
-                    continue;
-                }
-
                 const auto size = meta.buffer_metas.sizes[rep];
                 D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE;
                 const auto usage = meta.buffer_metas.usages[rep];
@@ -195,8 +234,79 @@ namespace render_graph
                 desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
                 desc.Flags = flags;
 
-                D3D12_HEAP_PROPERTIES heap{};
-                heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+                next_buffer_descs[slot] = desc;
+                next_buffer_physicals[slot] = static_cast<uint32_t>(physical_id);
+            }
+
+            // Keep the resources of slots whose physical id and description did not change (recompiles of the same
+            // graph, variant and plan swaps). Every other resource is retired: frames recorded with the previous
+            // plan may still use it (see retired_resources).
+            const auto retire_frames = std::max(previous_frames_in_flight, frames_in_flight);
+            images = keep_resources(std::move(images), image_descs, image_physicals, next_image_descs, next_image_physicals, retire_frames);
+            buffers = keep_resources(std::move(buffers), buffer_descs, buffer_physicals, next_buffer_descs, next_buffer_physicals, retire_frames);
+            image_descs = std::move(next_image_descs);
+            image_physicals = std::move(next_image_physicals);
+            buffer_descs = std::move(next_buffer_descs);
+            buffer_physicals = std::move(next_buffer_physicals);
+
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
+            {
+                if (image_is_imported[physical_id])
+                {
+                    const auto rep = physical_meta.physical_image_meta[physical_id];
+                    images[physical_id] = (rep < imported_images.size()) ? imported_images[rep] : nullptr; // AddRef
+                }
+            }
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            {
+                if (buffer_is_imported[physical_id])
+                {
+                    const auto rep = physical_meta.physical_buffer_meta[physical_id];
+                    buffers[physical_id] = (rep < imported_buffers.size()) ? imported_buffers[rep] : nullptr;
+                }
+            }
+
+            if (!device)
+            {
+                return;
+            }
+
+            D3D12_HEAP_PROPERTIES heap{};
+            heap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+            // Images
+            for (size_t slot = 0; slot < image_slot_count; slot++)
+            {
+                const auto& desc = image_descs[slot];
+                if (desc.Dimension == D3D12_RESOURCE_DIMENSION_UNKNOWN || images[slot])
+                {
+                    continue;
+                }
+
+                ComPtr resource;
+                const HRESULT hr = device->CreateCommittedResource(
+                    &heap,
+                    D3D12_HEAP_FLAG_NONE,
+                    &desc,
+                    D3D12_RESOURCE_STATE_COMMON,
+                    nullptr,
+                    IID_PPV_ARGS(resource.GetAddressOf()));
+
+                if (SUCCEEDED(hr))
+                {
+                    RG_PROFILE_ALLOCATION(resource_kind::image, slot, device->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes);
+                    images[slot] = resource;
+                }
+            }
+
+            // Buffers
+            for (size_t slot = 0; slot < buffer_slot_count; slot++)
+            {
+                const auto& desc = buffer_descs[slot];
+                if (desc.Dimension == D3D12_RESOURCE_DIMENSION_UNKNOWN || buffers[slot])
+                {
+                    continue;
+                }
 
                 ComPtr resource;
                 const HRESULT hr = device->CreateCommittedResource(
@@ -209,13 +319,70 @@ namespace render_graph
 
                 if (SUCCEEDED(hr))
                 {
-                    buffers[physical_id] = resource;
+                    RG_PROFILE_ALLOCATION(resource_kind::buffer, slot, desc.Width);
+                    buffers[slot] = resource;
                 }
             }
         }
 
+        // Keeps the resources of unchanged slots and retires the rest; imported slots (Dimension UNKNOWN) only
+        // drop their reference.
+        [[nodiscard]] std::vector<ComPtr> keep_resources(std::vector<ComPtr> previous,
+                                                         const std::vector<D3D12_RESOURCE_DESC>& previous_descs,
+                                                         const std::vector<uint32_t>& previous_physicals,
+                                                         const std::vector<D3D12_RESOURCE_DESC>& descs,
+                                                         const std::vector<uint32_t>& physicals,
+                                                         uint32_t retire_frames)
+        {
+            std::vector<ComPtr> next(descs.size());
+            for (size_t slot = 0; slot < previous.size(); slot++)
+            {
+                if (!previous[slot] || slot >= previous_descs.size() || previous_descs[slot].Dimension == D3D12_RESOURCE_DIMENSION_UNKNOWN)
+                {
+                    continue;
+                }
+                if (slot < descs.size() && physicals[slot] == previous_physicals[slot] && same_desc(descs[slot], previous_descs[slot]))
+                {
+                    next[slot] = std::move(previous[slot]);
+                    continue;
+                }
+                retired_resources.push_back(retired_resource{std::move(previous[slot]), begun_frames + retire_frames});
+            }
+            return next;
+        }
+
+        [[nodiscard]] static bool same_desc(const D3D12_RESOURCE_DESC& a, const D3D12_RESOURCE_DESC& b)
+        {
+            return a.Dimension == b.Dimension && a.Width == b.Width && a.Height == b.Height && a.DepthOrArraySize == b.DepthOrArraySize &&
+                   a.MipLevels == b.MipLevels && a.Format == b.Format && a.SampleDesc.Count == b.SampleDesc.Count &&
+                   a.Layout == b.Layout && a.Flags == b.Flags;
+        }
+
         void apply_barriers(pass_handle /*pass*/, const per_pass_barrier& /*plan*/) override {}
 
+        void on_begin_frame(uint32_t frame_in_flight) override
+        {
+            current_frame = frame_in_flight;
+            begun_frames++;
+            std::erase_if(retired_resources, [&](const retired_resource& retired) { return retired.release_at <= begun_frames; });
+        }
+
+        // Resolve a physical id (as used by the compiled plan) to the slot of the frame being recorded,
+        // or to the slot holding the previous frame's contents of a history resource (barrier_op::previous_frame).
+        [[nodiscard]] uint32_t resolve_image_slot(uint32_t physical, bool previous_frame = false) const
+        {
+            const auto frame = previous_frame ? (current_frame + frames_in_flight - 1) % frames_in_flight : current_frame;
+            const auto idx   = (static_cast<size_t>(physical) * frames_in_flight) + frame;
+            return (idx < physical_image_frame_slots.size()) ? physical_image_frame_slots[idx] : physical;
+        }
+
+        [[nodiscard]] uint32_t resolve_buffer_slot(uint32_t physical, bool previous_frame = false) const
+        {
+            const auto frame = previous_frame ? (current_frame + frames_in_flight - 1) % frames_in_flight : current_frame;
+            const auto idx   = (static_cast<size_t>(physical) * frames_in_flight) + frame;
+            return (idx < physical_buffer_frame_slots.size()) ? physical_buffer_frame_slots[idx] : physical;
+        }
+
         [[nodiscard]] uint32_t get_physical_image_id(resource_handle logical) const
         {
             if (logical >= logical_to_physical_img_id.size())
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <cmath>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "backend.h"
@@ -42,25 +45,37 @@ namespace render_graph
         output_table* output_table;
         pass_handle current_pass;
 
+        // Reads of the previous frame's contents (history); see read_image_previous_frame.
+        read_dependency* image_history_read_deps  = nullptr;
+        read_dependency* buffer_history_read_deps = nullptr;
+
+        // Image writes declared as full overwrites; see overwrite_image.
+        write_dependency* image_overwrite_deps = nullptr;
+
         // create
 
-        resource_handle create_image(const image_info& info) const { return meta_table->image_metas.add(info); }
-        resource_handle create_buffer(const buffer_info& info) const { return meta_table->buffer_metas.add(info); }
+        // Handles are stable across compiles: re-declaring a resource with the same name from the same pass
+        // returns the same handle (see resource_registry).
+        resource_handle create_image(const image_info& info) const { return meta_table->declare_image(info, current_pass); }
+        resource_handle create_buffer(const buffer_info& info) const { return meta_table->declare_buffer(info, current_pass); }
 
         // output
 
-        void declare_image_output(resource_handle resource) const
+        // views: outputs only needed by some views (reflection probe, picture-in-picture) pass their view mask.
+        void declare_image_output(resource_handle resource, view_mask views = all_views) const
         {
             // validate resource is an image
             assert(resource < meta_table->image_metas.names.size());
             output_table->image_outputs.push_back(resource);
+            output_table->image_output_views.push_back(views);
         }
 
-        void declare_buffer_output(resource_handle resource) const
+        void declare_buffer_output(resource_handle resource, view_mask views = all_views) const
         {
             // validate resource is a buffer
             assert(resource < meta_table->buffer_metas.names.size());
             output_table->buffer_outputs.push_back(resource);
+            output_table->buffer_output_views.push_back(views);
         }
 
         // read
@@ -78,6 +93,27 @@ namespace render_graph
             buffer_read_deps->lengthes[current_pass]++;
         }
 
+        // read previous frame
+        // Reads the contents the resource had at the end of the previous frame (its last version then),
+        // e.g. TAA history or last frame's depth. The resource must be written in this frame too; the system
+        // keeps it in two (or frames-in-flight) ping-pong allocations and emits the cross-frame barriers.
+        // Contents are undefined on the first frame after compile.
+
+        void read_image_previous_frame(resource_handle resource, image_usage usage) const
+        {
+            assert(image_history_read_deps != nullptr);
+            image_history_read_deps->read_list.push_back(resource);
+            image_history_read_deps->usage_bits.push_back(static_cast<uint32_t>(usage));
+            image_history_read_deps->lengthes[current_pass]++;
+        }
+        void read_buffer_previous_frame(resource_handle resource, buffer_usage usage) const
+        {
+            assert(buffer_history_read_deps != nullptr);
+            buffer_history_read_deps->read_list.push_back(resource);
+            buffer_history_read_deps->usage_bits.push_back(static_cast<uint32_t>(usage));
+            buffer_history_read_deps->lengthes[current_pass]++;
+        }
+
         // write
 
         void write_image(resource_handle resource, image_usage usage) const
@@ -92,6 +128,20 @@ namespace render_graph
             buffer_write_deps->usage_bits.push_back(static_cast<uint32_t>(usage));
             buffer_write_deps->lengthes[current_pass]++;
         }
+
+        // overwrite
+        // A write that replaces every texel without reading the previous contents (fullscreen pass, full-target
+        // draw): an attachment written this way is not loaded (attachment_load_op::dont_care). Plain
+        // write_image keeps earlier contents, since the pass may write only part of the image.
+
+        void overwrite_image(resource_handle resource, image_usage usage) const
+        {
+            assert(image_overwrite_deps != nullptr);
+            write_image(resource, usage);
+            image_overwrite_deps->write_list.push_back(resource);
+            image_overwrite_deps->usage_bits.push_back(static_cast<uint32_t>(usage));
+            image_overwrite_deps->lengthes[current_pass]++;
+        }
     };
 
     // context passed to the execution lambda
@@ -99,6 +149,15 @@ namespace render_graph
     {
         backend* backend;
         // void* command_buffer; // Abstract command buffer
+
+        // Per-frame parameters given to render_graph_system::execute(); nullptr if none.
+        const void* frame_params = nullptr;
+
+        template <typename T>
+        [[nodiscard]] const T* params() const
+        {
+            return static_cast<const T*>(frame_params);
+        }
     };
 
     // graph topology
@@ -111,14 +170,103 @@ namespace render_graph
         std::vector<pass_handle> passes;
         std::vector<pass_setup_func> setup_funcs;
         std::vector<pass_execute_func> execute_funcs;
+
+        // Disabled passes declare nothing (and are therefore never live); removed passes are tombstones
+        // whose handle is never reused.
+        std::vector<bool> enabled;
+        std::vector<bool> removed;
+
+        // Estimated GPU cost per pass in arbitrary units (default 1), used by critical-path scheduling.
+        std::vector<float> costs;
+
+        // Optional pass names; a named pass keeps its identity (and measured cost) across graph rebuilds.
+        std::vector<std::string> names;
+    };
+
+    // Exponentially smoothed measured pass durations, keyed by stable pass identity
+    // (render_graph_system::pass_identity). Same unit as the estimated costs.
+    // Scheduling reads the cost a pass was last scheduled with; it follows the smoothed duration once that moved by
+    // more than tolerance (relative), which bumps revision so that plans scheduled with older costs get rescheduled.
+    struct pass_cost_table
+    {
+        struct entry
+        {
+            float smoothed  = 0.0F;
+            float scheduled = 0.0F;
+        };
+
+        std::unordered_map<uint64_t, entry> entries;
+        float smoothing   = 0.2F;  // Weight of a new sample
+        float tolerance   = 0.05F; // Relative drift of a smoothed duration before it is rescheduled
+        uint64_t revision = 0;     // Bumped whenever a scheduled cost changes
+
+        void record(uint64_t key, float duration)
+        {
+            auto [it, inserted] = entries.try_emplace(key, entry{.smoothed = duration, .scheduled = duration});
+            if (inserted)
+            {
+                revision++;
+                return;
+            }
+            auto& cost = it->second;
+            cost.smoothed += smoothing * (duration - cost.smoothed);
+            if (std::fabs(cost.smoothed - cost.scheduled) > tolerance * cost.scheduled)
+            {
+                cost.scheduled = cost.smoothed;
+                revision++;
+            }
+        }
+
+        [[nodiscard]] const float* find(uint64_t key) const
+        {
+            const auto it = entries.find(key);
+            return (it != entries.end()) ? &it->second.scheduled : nullptr;
+        }
+
+        void clear()
+        {
+            entries.clear();
+            revision++;
+        }
+    };
+
+    // Retained mode: what a pass declared during the previous compile, so that an unchanged pass can be
+    // replayed from the previous dependency tables instead of invoking its setup function again.
+    // Dependency slices are found through the previous *_deps begins/lengthes of the pass.
+    struct pass_record
+    {
+        bool valid = false;
+
+        uint32_t image_output_begin   = 0;
+        uint32_t image_output_length  = 0;
+        uint32_t buffer_output_begin  = 0;
+        uint32_t buffer_output_length = 0;
+
+        std::vector<resource_handle> created_images;
+        std::vector<resource_handle> created_buffers;
+    };
+
+    // Hazards behind a DAG edge (bit mask; one edge can carry several).
+    enum class dependency_kind : uint8_t
+    {
+        read_after_write  = 1 << 0, // producer of a version -> reader of that version
+        write_after_read  = 1 << 1, // reader of a version -> writer of the next version
+        write_after_write = 1 << 2, // writer of a version -> writer of the next version
     };
 
     struct directed_acyclic_graph
     {
         std::vector<pass_handle> adjacency_list;
+        std::vector<uint8_t> edge_kinds; // Parallel to adjacency_list: dependency_kind bits
         std::vector<uint32_t> adjacency_begins;
         std::vector<uint32_t> in_degrees;
         std::vector<uint32_t> out_degrees;
+
+        // Transitive reduction (render_graph_system::set_transitive_reduction): the smallest edge set with the same
+        // reachability, in the same CSR layout. Empty when disabled.
+        std::vector<pass_handle> reduced_adjacency_list;
+        std::vector<uint32_t> reduced_adjacency_begins;
+        std::vector<uint32_t> reduced_in_degrees;
     };
 
 }; // namespace render_graph
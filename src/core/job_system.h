@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "rg_function.h"
+
+namespace render_graph
+{
+    // Job system interface used by every parallel part of the library (compile stages, execute_parallel).
+    // task_pool is the built-in implementation; an engine can implement this interface on top of its own
+    // scheduler instead, so several render graphs compiling at once share one set of threads.
+    class job_system
+    {
+    public:
+        using job = rg_function<void()>;
+
+        virtual ~job_system() = default;
+
+        [[nodiscard]] virtual uint32_t worker_count() const = 0;
+
+        // Runs work on some thread of the job system, eventually.
+        virtual void submit(job work) = 0;
+
+        // Returns once counter reached zero. Waits are issued from inside jobs too (a compile running as a job),
+        // so implementations should run queued jobs while waiting instead of blocking a worker; the default
+        // only yields, which is enough when the waiting thread is never one of the workers.
+        virtual void wait(const std::atomic<uint32_t>& counter)
+        {
+            while (counter.load(std::memory_order_acquire) != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // Runs fn(i) for every i in [0, count) as separate jobs and waits for all of them.
+        template <typename Fn>
+        void parallel_for(uint32_t count, Fn&& fn)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            std::atomic<uint32_t> remaining{count};
+            for (uint32_t i = 0; i < count; i++)
+            {
+                submit([&fn, &remaining, i]
+                       {
+                           fn(i);
+                           remaining.fetch_sub(1, std::memory_order_acq_rel);
+                       });
+            }
+            wait(remaining);
+        }
+    };
+} // namespace render_graph
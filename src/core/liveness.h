@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "resource.h"
+
+namespace render_graph
+{
+    // Dense pass x output-root liveness matrix.
+    // Row p holds one bit per output root (declared image outputs first, then buffer outputs, in
+    // output_table order): bit r is set iff pass p contributes to root r. Rows are packed in 64-bit words,
+    // so propagating liveness from a consumer to its producer is a word-wise OR over the row.
+    // Columns can be any dense index set; Step G also uses it as a pass x pass reachability matrix.
+    struct liveness_matrix
+    {
+        size_t pass_count    = 0;
+        size_t root_count    = 0;
+        size_t words_per_row = 0;
+        std::vector<uint64_t> words; // Row-major, size = pass_count * words_per_row
+
+        void reset(size_t passes, size_t roots)
+        {
+            pass_count    = passes;
+            root_count    = roots;
+            words_per_row = (roots + 63) / 64;
+            words.assign(pass_count * words_per_row, 0);
+        }
+
+        [[nodiscard]] uint64_t* row(pass_handle pass) noexcept { return words.data() + (static_cast<size_t>(pass) * words_per_row); }
+        [[nodiscard]] const uint64_t* row(pass_handle pass) const noexcept { return words.data() + (static_cast<size_t>(pass) * words_per_row); }
+
+        void set(pass_handle pass, size_t root) noexcept { row(pass)[root / 64] |= (1ULL << (root % 64)); }
+
+        [[nodiscard]] bool test(pass_handle pass, size_t root) const noexcept
+        {
+            if (pass >= pass_count || root >= root_count)
+            {
+                return false;
+            }
+            return (row(pass)[root / 64] & (1ULL << (root % 64))) != 0;
+        }
+
+        // row(dst) |= row(src); returns true if row(dst) changed.
+        bool merge_into(pass_handle dst, pass_handle src) noexcept
+        {
+            auto* to         = row(dst);
+            const auto* from = row(src);
+            uint64_t changed = 0;
+            for (size_t w = 0; w < words_per_row; w++)
+            {
+                const auto merged = to[w] | from[w];
+                changed |= merged ^ to[w];
+                to[w] = merged;
+            }
+            return changed != 0;
+        }
+
+        [[nodiscard]] bool any(pass_handle pass) const noexcept
+        {
+            const auto* bits = row(pass);
+            uint64_t acc     = 0;
+            for (size_t w = 0; w < words_per_row; w++)
+            {
+                acc |= bits[w];
+            }
+            return acc != 0;
+        }
+
+        // True if the pass is live for at least one root of the output set (see make_output_set).
+        [[nodiscard]] bool intersects(pass_handle pass, const std::vector<uint64_t>& output_set) const noexcept
+        {
+            if (pass >= pass_count)
+            {
+                return false;
+            }
+            const auto* bits = row(pass);
+            uint64_t acc     = 0;
+            for (size_t w = 0; w < words_per_row && w < output_set.size(); w++)
+            {
+                acc |= bits[w] & output_set[w];
+            }
+            return acc != 0;
+        }
+
+        [[nodiscard]] std::vector<uint64_t> make_output_set(const std::vector<size_t>& roots) const
+        {
+            std::vector<uint64_t> output_set(words_per_row, 0);
+            for (const auto root : roots)
+            {
+                if (root < root_count)
+                {
+                    output_set[root / 64] |= (1ULL << (root % 64));
+                }
+            }
+            return output_set;
+        }
+
+        void clear()
+        {
+            pass_count    = 0;
+            root_count    = 0;
+            words_per_row = 0;
+            words.clear();
+        }
+    };
+} // namespace render_graph
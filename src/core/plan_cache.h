@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "barrier.h"
+#include "graph.h"
+#include "liveness.h"
+#include "resource.h"
+
+namespace render_graph
+{
+    // Per-view subset of a multi-view compile (see render_graph_system::set_views).
+    // The schedule is the merged schedule filtered to the passes the view's outputs depend on; the barrier
+    // plan is only built for separate (non-merged) views.
+    struct view_plan
+    {
+        std::vector<bool> active_pass_flags;
+        std::vector<pass_handle> sorted_passes;
+        per_pass_barrier per_pass_barriers;
+    };
+
+    // Snapshot of everything compile() produces (see render_graph_system::save_plan / load_plan).
+    struct compiled_plan
+    {
+        // resource related
+        resource_meta_table meta_table;
+        read_dependency image_read_deps;
+        write_dependency image_write_deps;
+        read_dependency buffer_read_deps;
+        write_dependency buffer_write_deps;
+        read_dependency image_history_read_deps;
+        read_dependency buffer_history_read_deps;
+        write_dependency image_overwrite_deps;
+
+        std::vector<resource_version_handle> img_ver_read_handles;
+        std::vector<resource_version_handle> img_ver_write_handles;
+        std::vector<resource_version_handle> buf_ver_read_handles;
+        std::vector<resource_version_handle> buf_ver_write_handles;
+
+        version_producer_map producer_lookup_table;
+        output_table outputs;
+
+        resource_lifetime resource_lifetimes;
+        physical_resource_meta physical_resource_metas;
+
+        // pass related
+        directed_acyclic_graph dag;
+        std::vector<bool> active_pass_flags;
+        std::vector<pass_handle> sorted_passes;
+        liveness_matrix liveness;
+
+        per_pass_barrier per_pass_barriers;
+        per_pass_attachment per_pass_attachments;
+        std::vector<view_plan> view_plans;
+
+        uint64_t cost_revision = 0; // pass_cost_table::revision the schedule was built with
+    };
+
+    // LRU cache of compiled plans keyed by a 64-bit variant key.
+    // A handful of entries is expected (one per recurring graph shape), so a list is enough.
+    struct plan_cache
+    {
+        struct entry
+        {
+            uint64_t key = 0;
+            compiled_plan plan;
+        };
+
+        std::list<entry> entries; // Most recently used first
+        size_t capacity = 4;
+
+        uint64_t hits   = 0;
+        uint64_t misses = 0;
+
+        // Returns the cached plan for key (and marks it most recently used), or nullptr.
+        compiled_plan* find(uint64_t key)
+        {
+            for (auto it = entries.begin(); it != entries.end(); ++it)
+            {
+                if (it->key == key)
+                {
+                    entries.splice(entries.begin(), entries, it);
+                    hits++;
+                    return &entries.front().plan;
+                }
+            }
+            misses++;
+            return nullptr;
+        }
+
+        // Inserts (or replaces) the plan slot for key, evicting the least recently used entry if full.
+        compiled_plan& insert(uint64_t key)
+        {
+            for (auto it = entries.begin(); it != entries.end(); ++it)
+            {
+                if (it->key == key)
+                {
+                    entries.splice(entries.begin(), entries, it);
+                    return entries.front().plan;
+                }
+            }
+            while (!entries.empty() && entries.size() >= capacity)
+            {
+                entries.pop_back();
+            }
+            entries.push_front(entry{.key = key, .plan = {}});
+            return entries.front().plan;
+        }
+
+        void set_capacity(size_t count)
+        {
+            capacity = (count > 0) ? count : 1;
+            while (entries.size() > capacity)
+            {
+                entries.pop_back();
+            }
+        }
+
+        void clear() { entries.clear(); }
+    };
+} // namespace render_graph
@@ -0,0 +1,47 @@
+#pragma once
+
+// Profiler hooks
+// The library calls the RG_PROFILE_* macros below at compile() step boundaries, around every pass's
+// apply_barriers and execute function, and for every native resource the backends allocate. By default they
+// expand to nothing. To route them into an external profiler (Tracy, an in-house one), define
+// RENDER_GRAPH_PROFILER_INCLUDE (CMake cache variable of the same name) to a header that defines any subset of
+// them; undefined hooks keep the no-op default. The hooks are macros so that the header-only core does not
+// depend on the profiler and a disabled build contains no code for them.
+//
+// The same definitions must be visible to every translation unit that includes the library.
+//
+// RG_PROFILE_SCOPE(name)                 scoped zone, name is a string literal
+// RG_PROFILE_STAGE_BEGIN(name)           a compile() step starts, name is a const char* with static storage
+// RG_PROFILE_STAGE_END(name)             the step started with the same pointer ends
+// RG_PROFILE_PASS(pass, name)            scoped zone around a pass's execute function, name is a std::string_view
+//                                        (empty for unnamed passes)
+// RG_PROFILE_BARRIERS(pass, count)       scoped zone around apply_barriers of a pass with count barrier ops
+// RG_PROFILE_ALLOCATION(kind, slot, bytes) a backend allocated a native resource_kind for a physical slot
+
+#if defined(RENDER_GRAPH_PROFILER_INCLUDE)
+#include RENDER_GRAPH_PROFILER_INCLUDE
+#endif
+
+#ifndef RG_PROFILE_SCOPE
+#define RG_PROFILE_SCOPE(name)
+#endif
+
+#ifndef RG_PROFILE_STAGE_BEGIN
+#define RG_PROFILE_STAGE_BEGIN(name)
+#endif
+
+#ifndef RG_PROFILE_STAGE_END
+#define RG_PROFILE_STAGE_END(name)
+#endif
+
+#ifndef RG_PROFILE_PASS
+#define RG_PROFILE_PASS(pass, name)
+#endif
+
+#ifndef RG_PROFILE_BARRIERS
+#define RG_PROFILE_BARRIERS(pass, count)
+#endif
+
+#ifndef RG_PROFILE_ALLOCATION
+#define RG_PROFILE_ALLOCATION(kind, slot, bytes)
+#endif
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backend.h"
+
+namespace render_graph
+{
+    // Backend without a device: every callback appends to in-memory logs instead of calling a graphics API.
+    // Used to benchmark execute() overhead and to regression-test compiled plans (barriers, allocations,
+    // imported bindings) without a GPU. to_text() renders the logs deterministically (names instead of native
+    // handles where possible) for golden-file comparison.
+    //
+    // With logging disabled only the counters are updated, so execute() can be measured with a backend
+    // that does no per-op work.
+    class recording_backend final : public backend
+    {
+    public:
+        // Barrier ops of one executed pass are barrier_ops[barrier_begin, barrier_begin + barrier_count).
+        struct pass_record
+        {
+            uint64_t frame         = 0; // Index of the recorded frame (one per on_begin_frame)
+            pass_handle pass       = 0;
+            uint32_t barrier_begin = 0;
+            uint32_t barrier_count = 0;
+        };
+
+        // One native object the backend would create (imported slots are bound, not allocated).
+        struct allocation_record
+        {
+            resource_kind kind      = resource_kind::image;
+            uint32_t slot           = 0;
+            uint32_t physical       = 0;
+            resource_handle logical = 0; // Representative logical resource of the physical id
+            uint64_t size           = 0; // Buffers: bytes; images: 0 (see image_metas of the logical)
+            bool memoryless         = false;
+        };
+
+        struct binding_record
+        {
+            resource_kind kind      = resource_kind::image;
+            resource_handle logical = 0;
+            native_handle native    = 0;
+            native_handle view      = 0;
+        };
+
+        struct counters
+        {
+            uint64_t frames      = 0;
+            uint64_t passes      = 0;
+            uint64_t barrier_ops = 0;
+            uint64_t allocations = 0;
+            uint64_t bindings    = 0;
+            uint64_t compiles    = 0;
+        };
+
+        bool logging = true;
+
+        std::vector<pass_record> pass_log;
+        std::vector<barrier_op> barrier_ops;
+        std::vector<allocation_record> allocation_log;
+        std::vector<binding_record> binding_log;
+        counters stats;
+
+        // Names for to_text(), captured at allocation time and from on_pass_begin.
+        std::vector<std::string> image_names;
+        std::vector<std::string> buffer_names;
+        std::vector<std::string> pass_names; // Indexed by pass_handle
+
+        void set_logging(bool enabled) { logging = enabled; }
+
+        void clear_log()
+        {
+            pass_log.clear();
+            barrier_ops.clear();
+            allocation_log.clear();
+            binding_log.clear();
+            stats = counters{};
+        }
+
+        void on_compile_resource_allocation(const resource_meta_table& meta, const physical_resource_meta& physical_meta) override
+        {
+            stats.compiles++;
+            if (logging)
+            {
+                image_names  = meta.image_metas.names;
+                buffer_names = meta.buffer_metas.names;
+                allocation_log.clear();
+            }
+
+            const auto image_slot_count  = std::max(physical_meta.image_slot_to_physical.size(), physical_meta.physical_image_meta.size());
+            const auto buffer_slot_count = std::max(physical_meta.buffer_slot_to_physical.size(), physical_meta.physical_buffer_meta.size());
+
+            for (size_t slot = 0; slot < image_slot_count; slot++)
+            {
+                const auto physical = (slot < physical_meta.image_slot_to_physical.size()) ? physical_meta.image_slot_to_physical[slot] : static_cast<uint32_t>(slot);
+                const auto rep      = physical_meta.physical_image_meta[physical];
+                if (rep >= meta.image_metas.names.size() || meta.image_metas.is_imported[rep])
+                {
+                    continue;
+                }
+                stats.allocations++;
+                if (logging)
+                {
+                    allocation_log.push_back(allocation_record{
+                        .kind       = resource_kind::image,
+                        .slot       = static_cast<uint32_t>(slot),
+                        .physical   = physical,
+                        .logical    = rep,
+                        .size       = 0,
+                        .memoryless = physical < physical_meta.physical_image_memoryless.size() && physical_meta.physical_image_memoryless[physical],
+                    });
+                }
+            }
+
+            for (size_t slot = 0; slot < buffer_slot_count; slot++)
+            {
+                const auto physical = (slot < physical_meta.buffer_slot_to_physical.size()) ? physical_meta.buffer_slot_to_physical[slot] : static_cast<uint32_t>(slot);
+                const auto rep      = physical_meta.physical_buffer_meta[physical];
+                if (rep >= meta.buffer_metas.names.size() || meta.buffer_metas.is_imported[rep])
+                {
+                    continue;
+                }
+                stats.allocations++;
+                if (logging)
+                {
+                    allocation_log.push_back(allocation_record{
+                        .kind       = resource_kind::buffer,
+                        .slot       = static_cast<uint32_t>(slot),
+                        .physical   = physical,
+                        .logical    = rep,
+                        .size       = meta.buffer_metas.sizes[rep],
+                        .memoryless = false,
+                    });
+                }
+            }
+        }
+
+        void bind_imported_image(resource_handle logical_image, native_handle native_image, native_handle native_view = 0) override
+        {
+            stats.bindings++;
+            if (logging)
+            {
+                binding_log.push_back(binding_record{.kind = resource_kind::image, .logical = logical_image, .native = native_image, .view = native_view});
+            }
+        }
+
+        void bind_imported_buffer(resource_handle logical_buffer, native_handle native_buffer) override
+        {
+            stats.bindings++;
+            if (logging)
+            {
+                binding_log.push_back(binding_record{.kind = resource_kind::buffer, .logical = logical_buffer, .native = native_buffer, .view = 0});
+            }
+        }
+
+        void on_begin_frame(uint32_t /*frame_in_flight*/) override { stats.frames++; }
+
+        void apply_barriers(pass_handle pass, const per_pass_barrier& plan) override
+        {
+            const auto count = pass < plan.pass_lengths.size() ? plan.pass_lengths[pass] : 0U;
+            stats.passes++;
+            stats.barrier_ops += count;
+            if (!logging)
+            {
+                return;
+            }
+
+            pass_log.push_back(pass_record{
+                .frame         = stats.frames > 0 ? stats.frames - 1 : 0,
+                .pass          = pass,
+                .barrier_begin = static_cast<uint32_t>(barrier_ops.size()),
+                .barrier_count = count,
+            });
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const auto idx = plan.pass_begins[pass] + i;
+                barrier_ops.push_back(barrier_op{
+                    .type           = plan.types[idx],
+                    .kind           = plan.kinds[idx],
+                    .logical        = plan.logicals[idx],
+                    .physical       = plan.physicals[idx],
+                    .src_domain     = plan.src_domains[idx],
+                    .dst_domain     = plan.dst_domains[idx],
+                    .src_access     = plan.src_accesses[idx],
+                    .dst_access     = plan.dst_accesses[idx],
+                    .src_usage_bits = plan.src_usage_bits[idx],
+                    .dst_usage_bits = plan.dst_usage_bits[idx],
+                    .prev_logical   = plan.prev_logicals[idx],
+                    .previous_frame = plan.previous_frames[idx],
+                });
+            }
+        }
+
+        void on_pass_begin(pass_handle pass, std::string_view name) override
+        {
+            if (logging && !name.empty())
+            {
+                if (pass >= pass_names.size())
+                {
+                    pass_names.resize(static_cast<size_t>(pass) + 1);
+                }
+                pass_names[pass] = name;
+            }
+        }
+
+        // Deterministic text form of the logs, one record per line.
+        [[nodiscard]] std::string to_text() const
+        {
+            std::ostringstream out;
+            for (const auto& a : allocation_log)
+            {
+                out << "alloc " << kind_name(a.kind) << " slot " << a.slot << " physical " << a.physical << " " << resource_name(a.kind, a.logical);
+                if (a.kind == resource_kind::buffer)
+                {
+                    out << " size " << a.size;
+                }
+                if (a.memoryless)
+                {
+                    out << " memoryless";
+                }
+                out << "\n";
+            }
+            for (const auto& b : binding_log)
+            {
+                out << "bind " << kind_name(b.kind) << " " << resource_name(b.kind, b.logical) << " native " << b.native;
+                if (b.view != 0)
+                {
+                    out << " view " << b.view;
+                }
+                out << "\n";
+            }
+            for (const auto& p : pass_log)
+            {
+                out << "frame " << p.frame << " pass " << p.pass;
+                if (p.pass < pass_names.size() && !pass_names[p.pass].empty())
+                {
+                    out << " " << pass_names[p.pass];
+                }
+                out << "\n";
+                for (uint32_t i = 0; i < p.barrier_count; i++)
+                {
+                    const auto& op = barrier_ops[p.barrier_begin + i];
+                    out << "  " << op_name(op.type) << " " << kind_name(op.kind) << " " << resource_name(op.kind, op.logical) << " physical "
+                        << op.physical << " " << domain_name(op.src_domain) << ":" << access_name(op.src_access) << ":" << op.src_usage_bits << " -> "
+                        << domain_name(op.dst_domain) << ":" << access_name(op.dst_access) << ":" << op.dst_usage_bits;
+                    if (op.type == barrier_op_type::aliasing)
+                    {
+                        out << " after " << resource_name(op.kind, op.prev_logical);
+                    }
+                    if (op.previous_frame)
+                    {
+                        out << " previous_frame";
+                    }
+                    out << "\n";
+                }
+            }
+            return out.str();
+        }
+
+        bool write_golden(const std::string& path) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+            file << to_text();
+            return static_cast<bool>(file);
+        }
+
+        // Compares to_text() with a golden file. On mismatch, diff (if given) receives the first differing line.
+        bool matches_golden(const std::string& path, std::string* diff = nullptr) const
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                if (diff != nullptr)
+                {
+                    *diff = "missing golden file: " + path;
+                }
+                return false;
+            }
+            std::stringstream golden;
+            golden << file.rdbuf();
+
+            const auto expected = golden.str();
+            const auto actual   = to_text();
+            if (expected == actual)
+            {
+                return true;
+            }
+            if (diff != nullptr)
+            {
+                std::istringstream expected_lines(expected);
+                std::istringstream actual_lines(actual);
+                std::string expected_line;
+                std::string actual_line;
+                for (uint32_t line = 1;; line++)
+                {
+                    const bool has_expected = static_cast<bool>(std::getline(expected_lines, expected_line));
+                    const bool has_actual   = static_cast<bool>(std::getline(actual_lines, actual_line));
+                    if (!has_expected || !has_actual || expected_line != actual_line)
+                    {
+                        *diff = "line " + std::to_string(line) + ": expected \"" + (has_expected ? expected_line : "<eof>") + "\", got \"" +
+                                (has_actual ? actual_line : "<eof>") + "\"";
+                        break;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        [[nodiscard]] std::string resource_name(resource_kind kind, resource_handle logical) const
+        {
+            const auto& names = kind == resource_kind::image ? image_names : buffer_names;
+            if (logical < names.size() && !names[logical].empty())
+            {
+                return names[logical];
+            }
+            return "#" + std::to_string(logical);
+        }
+
+        static const char* kind_name(resource_kind kind) { return kind == resource_kind::image ? "image" : "buffer"; }
+
+        static const char* op_name(barrier_op_type type)
+        {
+            switch (type)
+            {
+            case barrier_op_type::transition: return "transition";
+            case barrier_op_type::uav: return "uav";
+            case barrier_op_type::aliasing: return "aliasing";
+            }
+            return "?";
+        }
+
+        static const char* domain_name(pipeline_domain domain)
+        {
+            switch (domain)
+            {
+            case pipeline_domain::any: return "any";
+            case pipeline_domain::graphics: return "graphics";
+            case pipeline_domain::compute: return "compute";
+            case pipeline_domain::copy: return "copy";
+            }
+            return "?";
+        }
+
+        static const char* access_name(access_type access)
+        {
+            switch (access)
+            {
+            case access_type::read: return "read";
+            case access_type::write: return "write";
+            case access_type::read_write: return "read_write";
+            }
+            return "?";
+        }
+    };
+} // namespace render_graph
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "resource_types.h"
@@ -95,6 +99,22 @@ namespace render_graph
             return handle;
         }
 
+        // Overwrite the meta of an existing (recycled or re-declared) handle.
+        void assign(resource_handle handle, const image_info& info)
+        {
+            names[handle]         = info.name;
+            formats[handle]       = info.fmt;
+            extents[handle]       = info.extent;
+            usages[handle]        = info.usage;
+            types[handle]         = info.type;
+            flags[handle]         = info.flags;
+            mip_levels[handle]    = info.mip_levels;
+            array_layers[handle]  = info.array_layers;
+            sample_counts[handle] = info.sample_counts;
+            is_imported[handle]   = info.imported;
+            is_transient[handle]  = !info.imported;
+        }
+
         [[nodiscard]] bool is_compatible(resource_handle a, resource_handle b) const noexcept
         {
             const auto count = static_cast<resource_handle>(names.size());
@@ -149,6 +169,16 @@ namespace render_graph
             return handle;
         }
 
+        // Overwrite the meta of an existing (recycled or re-declared) handle.
+        void assign(resource_handle handle, const buffer_info& info)
+        {
+            names[handle]        = info.name;
+            sizes[handle]        = info.size;
+            usages[handle]       = info.usage;
+            is_imported[handle]  = info.imported;
+            is_transient[handle] = !info.imported;
+        }
+
         [[nodiscard]] bool is_compatible(resource_handle a, resource_handle b) const noexcept
         {
             const auto count = static_cast<resource_handle>(names.size());
@@ -164,6 +194,131 @@ namespace render_graph
             names.clear();
             sizes.clear();
             usages.clear();
+            is_imported.clear();
+            is_transient.clear();
+        }
+    };
+
+    // Persistent resource identity across compiles.
+    // A resource is identified by a stable key = hash(name) mixed with the declaring pass (and an occurrence
+    // salt for repeated names within one pass). Re-declaring the same key returns the same handle; handles
+    // whose key is not declared during a compile are released and recycled by later declarations, so the
+    // meta tables stay bounded by the peak number of simultaneously declared resources.
+    struct resource_registry
+    {
+        std::unordered_map<uint64_t, resource_handle> key_to_handle;
+        std::vector<uint64_t> handle_keys;         // Indexed by resource_handle
+        std::vector<uint32_t> handle_epochs;       // Indexed by resource_handle, epoch of the last declaration
+        std::vector<bool> handle_alive;            // Indexed by resource_handle
+        std::vector<pass_handle> handle_passes;    // Indexed by resource_handle, declaring pass
+        std::vector<resource_handle> free_handles; // Released handles, reused LIFO
+        uint32_t epoch = 0;
+
+        [[nodiscard]] static uint64_t make_key(std::string_view name, pass_handle pass, uint32_t salt) noexcept
+        {
+            // FNV-1a over the name, then mix in pass and salt.
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for (const auto c : name)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x100000001B3ULL;
+            }
+            hash ^= (static_cast<uint64_t>(pass) << 32) | salt;
+            hash *= 0x100000001B3ULL;
+            hash ^= hash >> 29;
+            return hash;
+        }
+
+        [[nodiscard]] bool is_alive(resource_handle handle) const noexcept
+        {
+            return handle < handle_alive.size() && handle_alive[handle];
+        }
+
+        [[nodiscard]] size_t handle_count() const noexcept { return handle_keys.size(); }
+
+        void begin_epoch() { epoch++; }
+
+        // Returns the handle for (name, pass): the previous one if the key was declared before, otherwise a
+        // recycled or appended one (handle == handle_count() - 1 after an append).
+        resource_handle acquire(std::string_view name, pass_handle pass)
+        {
+            for (uint32_t salt = 0;; salt++)
+            {
+                const auto key = make_key(name, pass, salt);
+                const auto it  = key_to_handle.find(key);
+                if (it == key_to_handle.end())
+                {
+                    resource_handle handle = 0;
+                    if (!free_handles.empty())
+                    {
+                        handle = free_handles.back();
+                        free_handles.pop_back();
+                        handle_keys[handle]   = key;
+                        handle_epochs[handle] = epoch;
+                        handle_alive[handle]  = true;
+                        handle_passes[handle] = pass;
+                    }
+                    else
+                    {
+                        handle = static_cast<resource_handle>(handle_keys.size());
+                        handle_keys.push_back(key);
+                        handle_epochs.push_back(epoch);
+                        handle_alive.push_back(true);
+                        handle_passes.push_back(pass);
+                    }
+                    key_to_handle.emplace(key, handle);
+                    return handle;
+                }
+
+                // Already declared during this compile: a repeated name in the same pass, try the next salt.
+                if (handle_epochs[it->second] == epoch)
+                {
+                    continue;
+                }
+
+                handle_epochs[it->second] = epoch;
+                return it->second;
+            }
+        }
+
+        // Keep a live handle declared during the current epoch without hashing its key again
+        // (retained-mode replay of a pass whose declarations did not change).
+        void touch(resource_handle handle)
+        {
+            if (is_alive(handle))
+            {
+                handle_epochs[handle] = epoch;
+            }
+        }
+
+        // Release every handle not declared during the current epoch. Returns the number released.
+        size_t end_epoch()
+        {
+            size_t released = 0;
+            for (resource_handle handle = 0; handle < handle_keys.size(); handle++)
+            {
+                if (handle_alive[handle] && handle_epochs[handle] != epoch)
+                {
+                    key_to_handle.erase(handle_keys[handle]);
+                    handle_alive[handle] = false;
+                    free_handles.push_back(handle);
+                    released++;
+                }
+            }
+            // Recycle low handles first.
+            std::sort(free_handles.begin(), free_handles.end(), std::greater<resource_handle>());
+            return released;
+        }
+
+        void clear()
+        {
+            key_to_handle.clear();
+            handle_keys.clear();
+            handle_epochs.clear();
+            handle_alive.clear();
+            handle_passes.clear();
+            free_handles.clear();
+            epoch = 0;
         }
     };
 
@@ -173,10 +328,58 @@ namespace render_graph
         image_meta image_metas;
         buffer_meta buffer_metas;
 
+        // Stable identities of the entries above (see resource_registry).
+        resource_registry image_registry;
+        resource_registry buffer_registry;
+
+        // Declare a resource from a pass setup: returns its stable handle and (re)writes its meta.
+        resource_handle declare_image(const image_info& info, pass_handle pass)
+        {
+            const auto handle = image_registry.acquire(info.name, pass);
+            if (handle == image_metas.names.size())
+            {
+                image_metas.add(info);
+            }
+            else
+            {
+                image_metas.assign(handle, info);
+            }
+            return handle;
+        }
+
+        resource_handle declare_buffer(const buffer_info& info, pass_handle pass)
+        {
+            const auto handle = buffer_registry.acquire(info.name, pass);
+            if (handle == buffer_metas.names.size())
+            {
+                buffer_metas.add(info);
+            }
+            else
+            {
+                buffer_metas.assign(handle, info);
+            }
+            return handle;
+        }
+
+        void begin_declarations()
+        {
+            image_registry.begin_epoch();
+            buffer_registry.begin_epoch();
+        }
+
+        // Releases resources that were not re-declared since begin_declarations().
+        void end_declarations()
+        {
+            image_registry.end_epoch();
+            buffer_registry.end_epoch();
+        }
+
         void clear()
         {
             image_metas.clear();
             buffer_metas.clear();
+            image_registry.clear();
+            buffer_registry.clear();
         }
     };
 
@@ -212,10 +415,17 @@ namespace render_graph
         }
     };
 
+    // View mask of a declared output: bit v set if the output belongs to view v (see render_graph_system::set_views).
+    using view_mask               = uint32_t;
+    constexpr view_mask all_views = ~0U;
+    constexpr uint32_t max_views  = 32;
+
     struct output_table
     {
         std::vector<resource_handle> image_outputs;  // Indexed by image handle
         std::vector<resource_handle> buffer_outputs; // Indexed by buffer handle
+        std::vector<view_mask> image_output_views;   // Parallel to image_outputs
+        std::vector<view_mask> buffer_output_views;  // Parallel to buffer_outputs
     };
 
     struct resource_lifetime
@@ -234,17 +444,84 @@ namespace render_graph
 
     struct physical_resource_meta
     {
+        // Representative logical handle per physical id; invalid (max) for holes left by stable aliasing.
         std::vector<resource_handle> physical_image_meta;
         std::vector<uint32_t> handle_to_physical_img_id; // Indexed by resource_handle
         std::vector<resource_handle> physical_buffer_meta;
         std::vector<uint32_t> handle_to_physical_buf_id; // Indexed by resource_handle
 
+        // Indexed by physical image id.
+        // If true, every logical image sharing this physical id is only ever used as a color/depth
+        // attachment (never sampled, stored or copied, not imported, not an output), so its contents
+        // never leave the render passes. Backends may back it with lazily-allocated/memoryless memory.
+        std::vector<bool> physical_image_memoryless;
+
+        // Frames-in-flight replication.
+        // Physical ids whose contents must survive the CPU/GPU frame overlap (declared outputs) or be read
+        // by the next frame (history resources) get one slot per frame; all other physical ids share a single
+        // slot across frames. frames_in_flight is the slot ring length: the requested frames in flight, but
+        // at least 2 when history resources exist (ping-pong).
+        // For physical id p and frame f in [0, frames_in_flight):
+        //   slot = *_frame_slots[p * frames_in_flight + f]
+        // Slots [0, physical count) are the physical ids themselves (frame 0); replicas are appended after them.
+        // Backends allocate one native object per slot.
+        uint32_t frames_in_flight = 1;
+        std::vector<bool> physical_image_per_frame;       // Indexed by physical image id
+        std::vector<uint32_t> physical_image_frame_slots; // size = physical image count * frames_in_flight
+        std::vector<uint32_t> image_slot_to_physical;     // Indexed by slot
+        std::vector<bool> physical_buffer_per_frame;       // Indexed by physical buffer id
+        std::vector<uint32_t> physical_buffer_frame_slots; // size = physical buffer count * frames_in_flight
+        std::vector<uint32_t> buffer_slot_to_physical;     // Indexed by slot
+
+        // Number of logical resources alive in both the previous and this compile whose physical id changed
+        // (descriptors referring to them must be rewritten). See render_graph_system::stable_aliasing.
+        uint32_t image_mapping_changes  = 0;
+        uint32_t buffer_mapping_changes = 0;
+
+        // True if a history resource (read_*_previous_frame) is mapped to the physical id.
+        std::vector<bool> physical_image_history;  // Indexed by physical image id
+        std::vector<bool> physical_buffer_history; // Indexed by physical buffer id
+
+        [[nodiscard]] uint32_t resolve_image_slot(uint32_t physical, uint32_t frame) const noexcept
+        {
+            const auto idx = (static_cast<size_t>(physical) * frames_in_flight) + (frame % frames_in_flight);
+            return (idx < physical_image_frame_slots.size()) ? physical_image_frame_slots[idx] : physical;
+        }
+
+        [[nodiscard]] uint32_t resolve_buffer_slot(uint32_t physical, uint32_t frame) const noexcept
+        {
+            const auto idx = (static_cast<size_t>(physical) * frames_in_flight) + (frame % frames_in_flight);
+            return (idx < physical_buffer_frame_slots.size()) ? physical_buffer_frame_slots[idx] : physical;
+        }
+
+        // Slot holding the previous frame's contents of a history physical id.
+        [[nodiscard]] uint32_t resolve_image_history_slot(uint32_t physical, uint32_t frame) const noexcept
+        {
+            return resolve_image_slot(physical, (frame % frames_in_flight) + frames_in_flight - 1);
+        }
+
+        [[nodiscard]] uint32_t resolve_buffer_history_slot(uint32_t physical, uint32_t frame) const noexcept
+        {
+            return resolve_buffer_slot(physical, (frame % frames_in_flight) + frames_in_flight - 1);
+        }
+
         void clear()
         {
             physical_image_meta.clear();
             physical_buffer_meta.clear();
             handle_to_physical_img_id.clear();
             handle_to_physical_buf_id.clear();
+            physical_image_memoryless.clear();
+            physical_image_per_frame.clear();
+            physical_image_frame_slots.clear();
+            image_slot_to_physical.clear();
+            physical_buffer_per_frame.clear();
+            physical_buffer_frame_slots.clear();
+            buffer_slot_to_physical.clear();
+            physical_image_history.clear();
+            physical_buffer_history.clear();
+            image_mapping_changes  = 0;
+            buffer_mapping_changes = 0;
         }
     };
 
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "backend.h"
+#include "graph.h"
+
+namespace render_graph
+{
+    // GPU timeline simulator: a backend without a device that replays execute() on a modelled GPU.
+    // Every pass runs on one of three in-order queues (graphics, compute, copy; see set_pass_queue), preceded by
+    // its barrier batch on the same queue. A pass starts once its queue is free and all DAG predecessors have
+    // finished; a predecessor on another queue adds cross_queue_wait_us (semaphore signal/wait latency).
+    // Time a queue with submitted work spends waiting on a dependency is reported as an idle bubble.
+    //
+    // Usage: compile(), set_dependencies(system.dag), then execute() once per simulated frame and read
+    // last_frame / timeline. pass_durations_ms can be fed back into execute(frame_params, measured_durations).
+    class simulator_backend final : public backend
+    {
+    public:
+        static constexpr uint32_t queue_count = 3;
+
+        struct cost_model
+        {
+            float default_pass_us = 100.0F;
+
+            // Barrier cost = batch_us per non-empty batch + per op cost by type, scaled by resource kind.
+            float batch_us      = 1.0F;
+            float transition_us = 2.0F;
+            float uav_us        = 1.0F;
+            float aliasing_us   = 0.5F;
+            float image_scale   = 1.0F;
+            float buffer_scale  = 0.5F;
+
+            float cross_queue_wait_us = 10.0F;
+        };
+
+        struct pass_timing
+        {
+            pass_handle pass = 0;
+            uint32_t queue   = 0;
+            float begin_us   = 0.0F; // Barrier batch start
+            float execute_us = 0.0F; // Pass start (after its barriers)
+            float end_us     = 0.0F;
+        };
+
+        struct bubble
+        {
+            uint32_t queue    = 0;
+            float begin_us    = 0.0F;
+            float duration_us = 0.0F;
+        };
+
+        struct frame_report
+        {
+            float frame_time_us        = 0.0F;
+            float barrier_us           = 0.0F;
+            uint32_t cross_queue_waits = 0;
+            std::array<float, queue_count> busy_us{};
+            std::array<float, queue_count> bubble_us{};
+            std::array<float, queue_count> utilization{}; // busy_us / frame_time_us
+
+            [[nodiscard]] float total_bubble_us() const noexcept { return bubble_us[0] + bubble_us[1] + bubble_us[2]; }
+        };
+
+        cost_model costs;
+        uint64_t simulated_frames = 0;
+
+        frame_report last_frame;
+        std::vector<pass_timing> timeline; // Passes of the last frame in execution order
+        std::vector<bubble> bubbles;
+        std::vector<float> pass_durations_ms; // Indexed by pass handle, -1 for passes not executed
+
+        void set_cost_model(const cost_model& model) { costs = model; }
+
+        void set_pass_cost(pass_handle pass, float cost_us)
+        {
+            grow(pass);
+            pass_costs_us[pass] = std::max(cost_us, 0.0F);
+        }
+
+        // pipeline_domain::any runs on the graphics queue.
+        void set_pass_queue(pass_handle pass, pipeline_domain queue)
+        {
+            grow(pass);
+            pass_queues[pass] = queue_index(queue);
+        }
+
+        // Predecessors of every pass; call after each compile() that changes the DAG.
+        void set_dependencies(const directed_acyclic_graph& dag)
+        {
+            const auto pass_count = dag.adjacency_begins.empty() ? 0 : dag.adjacency_begins.size() - 1;
+            predecessor_begins.assign(pass_count + 1, 0);
+            for (const auto dst : dag.adjacency_list)
+            {
+                predecessor_begins[dst + 1]++;
+            }
+            for (size_t pass = 0; pass < pass_count; pass++)
+            {
+                predecessor_begins[pass + 1] += predecessor_begins[pass];
+            }
+            predecessors.assign(dag.adjacency_list.size(), 0);
+            auto cursor = predecessor_begins;
+            for (size_t src = 0; src < pass_count; src++)
+            {
+                for (auto i = dag.adjacency_begins[src]; i < dag.adjacency_begins[src + 1]; i++)
+                {
+                    predecessors[cursor[dag.adjacency_list[i]]++] = static_cast<pass_handle>(src);
+                }
+            }
+        }
+
+        void on_begin_frame(uint32_t /*frame_in_flight*/) override
+        {
+            simulated_frames++;
+            last_frame = frame_report{};
+            timeline.clear();
+            bubbles.clear();
+            queue_free_us.fill(0.0F);
+            pass_end_us.assign(pass_end_us.size(), -1.0F);
+            pass_durations_ms.assign(pass_durations_ms.size(), -1.0F);
+        }
+
+        void apply_barriers(pass_handle pass, const per_pass_barrier& plan) override
+        {
+            pending_barrier_us = 0.0F;
+            const auto count   = pass < plan.pass_lengths.size() ? plan.pass_lengths[pass] : 0U;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const auto idx = plan.pass_begins[pass] + i;
+                auto cost      = costs.transition_us;
+                if (plan.types[idx] == barrier_op_type::uav)
+                {
+                    cost = costs.uav_us;
+                }
+                else if (plan.types[idx] == barrier_op_type::aliasing)
+                {
+                    cost = costs.aliasing_us;
+                }
+                pending_barrier_us += cost * (plan.kinds[idx] == resource_kind::image ? costs.image_scale : costs.buffer_scale);
+            }
+            if (count > 0)
+            {
+                pending_barrier_us += costs.batch_us;
+            }
+        }
+
+        void on_pass_end(pass_handle pass) override
+        {
+            grow(pass);
+            const auto queue = pass_queues[pass];
+
+            // Ready when every predecessor has finished (plus semaphore latency across queues).
+            float ready_us = 0.0F;
+            if (static_cast<size_t>(pass) + 1 < predecessor_begins.size())
+            {
+                for (auto i = predecessor_begins[pass]; i < predecessor_begins[pass + 1]; i++)
+                {
+                    const auto pred = predecessors[i];
+                    if (pred >= pass_end_us.size() || pass_end_us[pred] < 0.0F)
+                    {
+                        continue; // Culled or not executed this frame
+                    }
+                    auto available = pass_end_us[pred];
+                    if (pass_queues[pred] != queue)
+                    {
+                        available += costs.cross_queue_wait_us;
+                        last_frame.cross_queue_waits++;
+                    }
+                    ready_us = std::max(ready_us, available);
+                }
+            }
+
+            // The queue sits idle while waiting for a dependency it cannot overlap.
+            const auto begin_us = std::max(queue_free_us[queue], ready_us);
+            if (begin_us > queue_free_us[queue])
+            {
+                bubbles.push_back(bubble{.queue = queue, .begin_us = queue_free_us[queue], .duration_us = begin_us - queue_free_us[queue]});
+                last_frame.bubble_us[queue] += begin_us - queue_free_us[queue];
+            }
+
+            const auto cost_us    = pass_costs_us[pass] >= 0.0F ? pass_costs_us[pass] : costs.default_pass_us;
+            const auto execute_us = begin_us + pending_barrier_us;
+            const auto end_us     = execute_us + cost_us;
+            timeline.push_back(pass_timing{.pass = pass, .queue = queue, .begin_us = begin_us, .execute_us = execute_us, .end_us = end_us});
+
+            queue_free_us[queue]    = end_us;
+            pass_end_us[pass]       = end_us;
+            pass_durations_ms[pass] = cost_us * 1e-3F;
+
+            last_frame.busy_us[queue] += end_us - begin_us;
+            last_frame.barrier_us += pending_barrier_us;
+            last_frame.frame_time_us = std::max(last_frame.frame_time_us, end_us);
+            for (uint32_t q = 0; q < queue_count; q++)
+            {
+                last_frame.utilization[q] = last_frame.frame_time_us > 0.0F ? last_frame.busy_us[q] / last_frame.frame_time_us : 0.0F;
+            }
+            pending_barrier_us = 0.0F;
+        }
+
+    private:
+        static uint32_t queue_index(pipeline_domain domain)
+        {
+            switch (domain)
+            {
+            case pipeline_domain::compute: return 1;
+            case pipeline_domain::copy: return 2;
+            default: return 0;
+            }
+        }
+
+        void grow(pass_handle pass)
+        {
+            if (pass >= pass_costs_us.size())
+            {
+                const auto size = static_cast<size_t>(pass) + 1;
+                pass_costs_us.resize(size, -1.0F);
+                pass_queues.resize(size, 0);
+                pass_end_us.resize(size, -1.0F);
+                pass_durations_ms.resize(size, -1.0F);
+            }
+        }
+
+        std::vector<float> pass_costs_us; // -1 = cost_model::default_pass_us
+        std::vector<uint32_t> pass_queues;
+        std::vector<uint32_t> predecessor_begins;
+        std::vector<pass_handle> predecessors;
+
+        std::array<float, queue_count> queue_free_us{};
+        std::vector<float> pass_end_us;
+        float pending_barrier_us = 0.0F;
+    };
+} // namespace render_graph
@@ -1,15 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <limits>
+#include <mutex>
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "backend.h"
 #include "barrier.h"
 #include "graph.h"
+#include "job_system.h"
+#include "liveness.h"
+#include "plan_cache.h"
+#include "profiler.h"
 #include "resource.h"
+#include "trace.h"
 
 namespace render_graph
 {
@@ -23,6 +33,11 @@ namespace render_graph
         read_dependency buffer_read_deps;
         write_dependency buffer_write_deps;
 
+        // Previous-frame (history) reads; no intra-frame producer, resolved against the previous frame's slot.
+        read_dependency image_history_read_deps;
+        read_dependency buffer_history_read_deps;
+        write_dependency image_overwrite_deps;
+
         // Versioned dependency views generated during compile().
         // These are compile-time/internal and are derived from *_deps + versioning rules.
         std::vector<resource_version_handle> img_ver_read_handles;
@@ -42,6 +57,9 @@ namespace render_graph
         std::vector<bool> active_pass_flags;
         std::vector<pass_handle> sorted_passes;
 
+        // Per-output liveness generated by Step D when bitset_liveness is enabled (see is_pass_live_for).
+        liveness_matrix liveness;
+
         // backend related
         backend* backend = nullptr;
 
@@ -49,8 +67,349 @@ namespace render_graph
         // Indexed by pass_handle; only active passes are consumed by execute().
         per_pass_barrier per_pass_barriers;
 
+        // Attachment load/store ops generated during compile().
+        // Indexed by pass_handle; derived from resource versions (Step B) and lifetimes (Step H).
+        per_pass_attachment per_pass_attachments;
+
+        // frames in flight
+        // Number of frames the CPU may record ahead of the GPU. Physical resources that must persist across
+        // the overlap are replicated per frame; execute() cycles through the frames.
+        uint32_t frames_in_flight = 1;
+        uint64_t frame_counter    = 0;
+
+        // begin_frame() starts the next frame: the backend's on_begin_frame() runs once per frame, with the next
+        // frame-in-flight slot. execute(), execute_parallel() and compile_and_execute() run a whole frame and begin
+        // it themselves unless begin_frame() was called before them. execute_view() calls share the current frame;
+        // executing a view a second time begins the next one, so begin_frame() before the views is optional.
+        bool frame_open = false;       // begun by begin_frame(), not yet used by a whole-frame execute
+        std::vector<bool> frame_views; // separate views executed in the current frame
+
         void set_backend(class backend* backend_ptr) { backend = backend_ptr; }
 
+        void set_frames_in_flight(uint32_t count) { frames_in_flight = std::max(count, 1U); }
+
+        // stable aliasing
+        // When enabled, Step H prefers the previous compile's logical -> physical mapping, so bindless descriptors
+        // of unrelated resources survive small graph changes. physical_resource_meta::*_mapping_changes reports
+        // how many mappings changed either way.
+        bool stable_aliasing = false;
+
+        void set_stable_aliasing(bool enabled) { stable_aliasing = enabled; }
+
+        // bitset liveness
+        // Step D culls with a pass x output-root bit matrix instead of the worklist. Active flags are identical;
+        // in addition, liveness answers "is pass P live for output set S" without another traversal.
+        bool bitset_liveness = false;
+
+        void set_bitset_liveness(bool enabled) { bitset_liveness = enabled; }
+
+        // transitive reduction
+        // Step G additionally computes dag.reduced_*: edges implied by a longer path are dropped, so consumers of
+        // the DAG (queue sync, parallel recording) see the minimal dependency set. The full DAG is unchanged.
+        bool transitive_reduction = false;
+
+        void set_transitive_reduction(bool enabled) { transitive_reduction = enabled; }
+
+        // critical-path scheduling
+        // Step G takes ready passes by bottom level (own cost plus the most expensive path after the pass) instead
+        // of FIFO, so long dependency chains start first. critical_path_length is the longest cost path of the
+        // last compile and is computed either way.
+        bool critical_path_scheduling = false;
+        float critical_path_length    = 0.0F;
+
+        void set_critical_path_scheduling(bool enabled) { critical_path_scheduling = enabled; }
+
+        void set_pass_cost(pass_handle pass, float cost)
+        {
+            if (pass < graph.costs.size())
+            {
+                graph.costs[pass] = std::max(cost, 0.0F);
+            }
+        }
+
+        // measured costs
+        // execute(frame_params, measured_durations) feeds per-pass durations (GPU timestamps, a simulator) into an
+        // exponentially smoothed table keyed by pass identity. The next compile() schedules with the smoothed
+        // duration of a pass instead of its estimate. Measurements alone do not trigger a recompile and are not
+        // part of the structural hash. With critical-path scheduling, once a cost drifted past the tolerance, a
+        // retained-mode compile() with nothing dirty and a compile_variant() hit rerun Steps G-J only, over the
+        // kept (or cached) declarations, versions and DAG.
+        pass_cost_table measured_costs;
+        uint64_t scheduled_cost_revision = 0; // measured_costs.revision the current schedule was built with
+
+        [[nodiscard]] bool costs_changed() const noexcept
+        {
+            return critical_path_scheduling && scheduled_cost_revision != measured_costs.revision;
+        }
+
+        void set_pass_name(pass_handle pass, std::string name)
+        {
+            if (pass < graph.names.size())
+            {
+                graph.names[pass] = std::move(name);
+            }
+        }
+
+        [[nodiscard]] const std::string& pass_name(pass_handle pass) const
+        {
+            assert(pass < graph.names.size() && "Error: invalid pass handle!");
+            return graph.names[pass];
+        }
+
+        void set_cost_smoothing(float factor) { measured_costs.smoothing = std::clamp(factor, 0.0F, 1.0F); }
+        void set_cost_tolerance(float relative) { measured_costs.tolerance = std::max(relative, 0.0F); }
+
+        // tracing
+        // With a recorder set, compile() records one span per step and execution records apply_barriers and the
+        // execute function of every pass as separate spans (see trace_recorder::to_chrome_json).
+        trace_recorder* tracer = nullptr;
+
+        void set_tracer(trace_recorder* recorder) { tracer = recorder; }
+
+        // job system
+        // With a job system set, compile() builds the per-view plans and the barrier plans (merged and per view)
+        // as parallel jobs, and execute_parallel() runs passes on it. Several systems may share one job system.
+        // Setup functions always run serially in pass order: they allocate resource handles.
+        job_system* jobs = nullptr;
+
+        void set_job_system(job_system* job_system_in) { jobs = job_system_in; }
+
+        // fn(i) for i in [0, count): as jobs when a job system is set, inline otherwise.
+        template <typename Fn>
+        void for_each_parallel(uint32_t count, Fn&& fn)
+        {
+            if (jobs != nullptr && count > 1)
+            {
+                jobs->parallel_for(count, fn);
+                return;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                fn(i);
+            }
+        }
+
+        // pipelined compile
+        // Lets compile() for frame N+1 overlap execute() of frame N. Execution reads front_plan, the last swapped
+        // plan; compile() writes the system members and, at its end, snapshots them into back_plan on the compile
+        // thread. begin_compile() runs compile() as a job on the job system (inline without one), swap_plans()
+        // waits for it and publishes the back plan: it swaps it with the front and notifies the backend
+        // (allocation, attachment ops), which compile() does not do in this mode since the backend's resources
+        // may still be in use. The members stay the compile state that retained replay reads.
+        // Between begin_compile() and swap_plans() the graph must not be edited; measured durations passed to
+        // execute() are kept and recorded at the swap. swap_plans() must not overlap execution.
+        // While a compile is in flight the worker writes every compiled member (sorted_passes, dag, view_plans,
+        // critical_path_length, liveness, physical_resource_metas, ...). Only front_plan and executed_plan() may
+        // be read until wait_for_compile() or swap_plans() returned.
+        bool pipelined_compile = false;
+        bool back_plan_dirty   = false; // back_plan holds a plan that was not swapped in yet
+        uint64_t plan_swaps    = 0;
+        compiled_plan front_plan;
+        compiled_plan back_plan;
+        std::atomic<uint32_t> compile_in_flight{0};
+        std::vector<float> pending_durations; // Passed to execute(), recorded at the next swap
+
+        void set_pipelined_compile(bool enabled)
+        {
+            wait_for_compile();
+            pipelined_compile = enabled;
+
+            // Nothing to publish before the first compile (or compile_variant() hit): swapping in an empty plan
+            // would hand the backend an empty allocation.
+            if (active_pass_flags.empty())
+            {
+                return;
+            }
+            back_plan_dirty = true;
+            if (enabled)
+            {
+                save_plan(back_plan);
+            }
+        }
+
+        void begin_compile()
+        {
+            assert(compile_in_flight.load() == 0 && "Error: begin_compile while a compile is in flight!");
+            if (jobs == nullptr)
+            {
+                compile();
+                return;
+            }
+            compile_in_flight.store(1, std::memory_order_release);
+            jobs->submit([this]
+                         {
+                             compile();
+                             compile_in_flight.store(0, std::memory_order_release);
+                         });
+        }
+
+        void wait_for_compile()
+        {
+            if (jobs != nullptr)
+            {
+                jobs->wait(compile_in_flight);
+            }
+        }
+
+        void swap_plans()
+        {
+            wait_for_compile();
+            if (!pending_durations.empty())
+            {
+                record_pass_durations(pending_durations);
+                pending_durations.clear();
+            }
+            if (!back_plan_dirty)
+            {
+                return;
+            }
+            std::swap(front_plan, back_plan);
+            back_plan_dirty = false;
+            plan_swaps++;
+            if (backend != nullptr)
+            {
+                backend->on_compile_resource_allocation(front_plan.meta_table, front_plan.physical_resource_metas);
+                backend->on_compile_attachment_ops(front_plan.per_pass_attachments);
+            }
+        }
+
+        // streaming execution
+        // compile_and_execute() starts executing the merged schedule before compile() has finished: once Step H
+        // fixed the physical mapping, the backend allocates and the longest final prefix of the schedule (at most
+        // stream_pass_limit passes) executes with its own barrier plan while Step I builds the plans for the
+        // rest. The barrier walk is causal except for cross-frame ordering, which prepends barriers to the first
+        // use of history ids and, with several frames in flight, of shared ids. The prefix ends before the first
+        // pass touching a history id; the wrap-around source of shared ids (their last use in the schedule) is
+        // known once the schedule is, so the prefix plan includes those barriers. With a job system the prefix
+        // runs as a job, otherwise inline; the remaining passes execute once compile() returned. 0 turns streaming
+        // off. Pipelined compiles execute a front plan and cannot stream: compile_and_execute() asserts that
+        // streaming is off for them.
+        // Only Step I overlaps the prefix. Setup, culling, the DAG, scheduling and Step H (lifetimes and aliasing
+        // over the whole graph, usually the most expensive step) still run before the first pass, so the saving
+        // is bounded by the barrier build of the passes after the prefix.
+        uint32_t stream_pass_limit      = 0;
+        uint32_t streamed_passes        = 0; // Passes of the merged schedule executed during the last compile()
+        bool streaming_frame            = false;
+        const void* stream_frame_params = nullptr;
+        std::vector<pass_handle> stream_schedule;
+        per_pass_barrier stream_barriers;
+        std::atomic<uint32_t> stream_in_flight{0};
+
+        void set_streaming_execution(uint32_t max_prefix_passes) { stream_pass_limit = max_prefix_passes; }
+
+        // Named passes are identified by name, unnamed ones by handle.
+        [[nodiscard]] uint64_t pass_identity(pass_handle pass) const noexcept
+        {
+            if (pass < graph.names.size() && !graph.names[pass].empty())
+            {
+                return resource_registry::make_key(graph.names[pass], 0, 0);
+            }
+            return resource_registry::make_key({}, pass, 1);
+        }
+
+        // Durations indexed by pass handle; negative entries carry no sample.
+        void record_pass_durations(const std::vector<float>& measured_durations)
+        {
+            const auto count = std::min(measured_durations.size(), graph.passes.size());
+            for (pass_handle pass = 0; pass < count; pass++)
+            {
+                if (measured_durations[pass] >= 0.0F && !graph.removed[pass])
+                {
+                    measured_costs.record(pass_identity(pass), measured_durations[pass]);
+                }
+            }
+        }
+
+        // views
+        // Several views (main, reflection probes, shadow maps, picture-in-picture) share one graph and differ in
+        // their outputs (declare_*_output view mask). Versions, producer map, DAG and the merged schedule are built
+        // once; view_plans[v] holds the passes and schedule of view v. Merged views execute as one combined schedule
+        // with shared resources (execute()). Separate views also get their own barrier plan over the shared
+        // physical resources and are executed one at a time with execute_view(); a frame that renders several
+        // views back to back should use the merged schedule.
+        uint32_t view_count = 1;
+        bool merge_views    = true;
+        std::vector<view_plan> view_plans;
+
+        void set_views(uint32_t count, bool merged = true)
+        {
+            assert(count <= max_views && "Error: Too many views!");
+            view_count  = std::clamp(count, 1U, max_views);
+            merge_views = merged;
+        }
+
+        // Output set over the declared outputs of the last compile (unknown handles are ignored).
+        [[nodiscard]] std::vector<uint64_t> make_output_set(const std::vector<resource_handle>& images,
+                                                            const std::vector<resource_handle>& buffers = {}) const
+        {
+            std::vector<size_t> roots;
+            const auto image_root_count = output_table.image_outputs.size();
+            for (size_t root = 0; root < image_root_count; root++)
+            {
+                if (std::find(images.begin(), images.end(), output_table.image_outputs[root]) != images.end())
+                {
+                    roots.push_back(root);
+                }
+            }
+            for (size_t root = 0; root < output_table.buffer_outputs.size(); root++)
+            {
+                if (std::find(buffers.begin(), buffers.end(), output_table.buffer_outputs[root]) != buffers.end())
+                {
+                    roots.push_back(image_root_count + root);
+                }
+            }
+            return liveness.make_output_set(roots);
+        }
+
+        [[nodiscard]] bool is_pass_live_for(pass_handle pass, const std::vector<uint64_t>& output_set) const
+        {
+            assert(bitset_liveness && "Error: is_pass_live_for requires bitset liveness!");
+            return liveness.intersects(pass, output_set);
+        }
+
+        // variant cache
+        // Compiled plans of recurring graph shapes (e.g. quality feature masks), see compile_variant().
+        // Setup functions are opaque, so a plan can only be reused while the same functions are installed:
+        // graph_revision changes whenever passes are added, removed or replaced, and the cache is dropped with
+        // it because no older entry can match again. Rebuilding an identical graph therefore misses. Enabling/
+        // disabling passes is part of the structural hash instead, so shapes toggled with set_pass_enabled()
+        // stay cached.
+        plan_cache variant_cache;
+        uint64_t graph_revision = 0;
+
+        void set_variant_cache_capacity(size_t count) { variant_cache.set_capacity(count); }
+
+        void bump_graph_revision()
+        {
+            graph_revision++;
+            variant_cache.clear();
+        }
+
+        // retained mode
+        // Setup functions only run for passes marked dirty (and passes never compiled); every other pass has its
+        // declarations replayed from the previous compile's tables. compile() returns immediately when nothing
+        // is dirty and the structure is unchanged. Per-frame data goes to execute(frame_params) instead.
+        bool retained_mode = false;
+        std::vector<bool> pass_dirty_flags;
+        std::vector<pass_record> pass_records;
+        uint64_t compiled_structure = 0;
+
+        void set_retained_mode(bool enabled)
+        {
+            retained_mode = enabled;
+            mark_all_passes_dirty();
+        }
+
+        void mark_pass_dirty(pass_handle pass)
+        {
+            if (pass < pass_dirty_flags.size())
+            {
+                pass_dirty_flags[pass] = true;
+            }
+        }
+
+        void mark_all_passes_dirty() { pass_dirty_flags.assign(graph.passes.size(), true); }
+
         // 1. Add Pass System
         // Separates resource definition (setup) from execution logic.
 
@@ -58,19 +417,159 @@ namespace render_graph
         pass_handle add_pass(SetupFn&& setup, ExecuteFn&& execute)
         {
             auto handle = static_cast<pass_handle>(graph.passes.size());
+            bump_graph_revision();
             graph.passes.push_back(handle);
             graph.setup_funcs.push_back(std::forward<SetupFn>(setup));
             graph.execute_funcs.push_back(std::forward<ExecuteFn>(execute));
+            graph.enabled.push_back(true);
+            graph.removed.push_back(false);
+            graph.costs.push_back(1.0F);
+            graph.names.emplace_back();
+            on_pass_edited(handle);
+            return handle;
+        }
+
+        // Named pass: the name labels traces and backend markers and identifies the pass for measured costs.
+        template <typename SetupFn = pass_setup_func, typename ExecuteFn = pass_execute_func>
+        pass_handle add_pass(std::string name, SetupFn&& setup, ExecuteFn&& execute)
+        {
+            const auto handle   = add_pass(std::forward<SetupFn>(setup), std::forward<ExecuteFn>(execute));
+            graph.names[handle] = std::move(name);
             return handle;
         }
 
+        // Graph editing
+        // Pass handles stay valid for the lifetime of the system: a removed pass becomes a tombstone (no setup,
+        // no execute, never live) and a disabled pass declares nothing. Each edit marks the pass dirty; the next
+        // compile() runs only the edited passes' setup and replays the declarations of every other pass
+        // (as in retained mode). Versions, the producer map, culling flags, DAG edges and the topological order
+        // are then updated for the resources the edited passes declare (before or after the edit) and the passes
+        // using them (compile_edits); lifetimes, aliasing and barriers (Steps H-J) are still rebuilt over the
+        // whole graph. If more than replay_edit_threshold of the passes were edited, every setup function is
+        // invoked again and the graph is compiled from scratch. So are graphs with history reads or several
+        // views, and compiles with bitset_liveness.
+        float replay_edit_threshold = 0.25F;
+        bool pending_edits          = false;
+
+        // Passes reading or writing each resource (in pass order) in the last compile, for compile_edits.
+        std::vector<std::vector<pass_handle>> image_accessors;
+        std::vector<std::vector<pass_handle>> buffer_accessors;
+
+        // Statistics of the last compile(). last_compile_replayed_setup is set when graph edits were applied by
+        // replaying the setup of the clean passes, last_compile_incremental when Steps B-G were also only
+        // updated around the edited passes.
+        uint32_t last_setup_invocations  = 0;
+        bool last_compile_replayed_setup = false;
+        bool last_compile_incremental    = false;
+
+        void remove_pass(pass_handle pass)
+        {
+            if (pass >= graph.passes.size() || graph.removed[pass])
+            {
+                return;
+            }
+            graph.removed[pass]       = true;
+            graph.enabled[pass]       = false;
+            graph.setup_funcs[pass]   = pass_setup_func{};
+            graph.execute_funcs[pass] = pass_execute_func{};
+            bump_graph_revision();
+            on_pass_edited(pass);
+        }
+
+        template <typename SetupFn = pass_setup_func, typename ExecuteFn = pass_execute_func>
+        void replace_pass(pass_handle pass, SetupFn&& setup, ExecuteFn&& execute)
+        {
+            if (pass >= graph.passes.size() || graph.removed[pass])
+            {
+                return;
+            }
+            graph.setup_funcs[pass]   = std::forward<SetupFn>(setup);
+            graph.execute_funcs[pass] = std::forward<ExecuteFn>(execute);
+            bump_graph_revision();
+            on_pass_edited(pass);
+        }
+
+        void set_pass_enabled(pass_handle pass, bool enabled)
+        {
+            if (pass >= graph.passes.size() || graph.removed[pass] || graph.enabled[pass] == enabled)
+            {
+                return;
+            }
+            graph.enabled[pass] = enabled;
+            on_pass_edited(pass);
+        }
+
+        void on_pass_edited(pass_handle pass)
+        {
+            pending_edits = true;
+            pass_dirty_flags.resize(graph.passes.size(), true);
+            pass_dirty_flags[pass] = true;
+        }
+
         // 2. Compile System
 
         void compile()
         {
+            RG_PROFILE_SCOPE("render_graph::compile");
+
             const auto pass_count   = graph.passes.size();
             const auto invalid_pass = std::numeric_limits<pass_handle>::max();
-            const auto invalid_resource = std::numeric_limits<resource_handle>::max();
+            trace_stage compile_trace(tracer, "compile");
+            streamed_passes = 0;
+
+            // Retained mode: the previous plan is still valid if nothing changed.
+            pass_dirty_flags.resize(pass_count, true);
+            pass_records.resize(pass_count);
+            const auto dirty_count = static_cast<size_t>(std::count(pass_dirty_flags.begin(), pass_dirty_flags.end(), true));
+            if (retained_mode && compiled_structure == structural_hash() && dirty_count == 0)
+            {
+                if (costs_changed())
+                {
+                    back_plan_dirty        = true;
+                    last_setup_invocations = 0;
+                    compile_schedule(compile_trace);
+                }
+                return;
+            }
+            back_plan_dirty = true;
+
+            // Graph edits: replay untouched passes unless too much of the graph changed.
+            last_compile_replayed_setup = pending_edits && compiled_structure != 0 &&
+                                          static_cast<float>(dirty_count) <= replay_edit_threshold * static_cast<float>(pass_count);
+            if (pending_edits && !last_compile_replayed_setup)
+            {
+                mark_all_passes_dirty();
+            }
+            pending_edits            = false;
+            last_setup_invocations   = 0;
+            const bool replay_passes = retained_mode || last_compile_replayed_setup;
+
+            // Keep the previous declarations for replaying clean passes, and what Steps B-G derived from them for
+            // applying graph edits (compile_edits).
+            declaration_snapshot previous;
+            if (replay_passes)
+            {
+                previous.image_read_deps          = std::move(image_read_deps);
+                previous.image_write_deps         = std::move(image_write_deps);
+                previous.buffer_read_deps         = std::move(buffer_read_deps);
+                previous.buffer_write_deps        = std::move(buffer_write_deps);
+                previous.image_history_read_deps  = std::move(image_history_read_deps);
+                previous.buffer_history_read_deps = std::move(buffer_history_read_deps);
+                previous.image_overwrite_deps     = std::move(image_overwrite_deps);
+                previous.output_table             = std::move(output_table);
+            }
+            if (last_compile_replayed_setup)
+            {
+                previous.img_ver_read_handles  = std::move(img_ver_read_handles);
+                previous.img_ver_write_handles = std::move(img_ver_write_handles);
+                previous.buf_ver_read_handles  = std::move(buf_ver_read_handles);
+                previous.buf_ver_write_handles = std::move(buf_ver_write_handles);
+                previous.producer_lookup_table = std::move(producer_lookup_table);
+                previous.active_pass_flags     = std::move(active_pass_flags);
+                previous.dag                   = std::move(dag);
+                previous.sorted_passes         = std::move(sorted_passes);
+            }
+            std::vector<pass_handle> edited_passes;
 
             // Reset dependency storage
             image_read_deps.read_list.clear();
@@ -89,27 +588,65 @@ namespace render_graph
             buffer_write_deps.usage_bits.clear();
             buffer_write_deps.begins.assign(pass_count, 0);
             buffer_write_deps.lengthes.assign(pass_count, 0);
+            image_history_read_deps.read_list.clear();
+            image_history_read_deps.usage_bits.clear();
+            image_history_read_deps.begins.assign(pass_count, 0);
+            image_history_read_deps.lengthes.assign(pass_count, 0);
+            buffer_history_read_deps.read_list.clear();
+            buffer_history_read_deps.usage_bits.clear();
+            buffer_history_read_deps.begins.assign(pass_count, 0);
+            buffer_history_read_deps.lengthes.assign(pass_count, 0);
+            image_overwrite_deps.write_list.clear();
+            image_overwrite_deps.usage_bits.clear();
+            image_overwrite_deps.begins.assign(pass_count, 0);
+            image_overwrite_deps.lengthes.assign(pass_count, 0);
             output_table.image_outputs.clear();
             output_table.buffer_outputs.clear();
+            output_table.image_output_views.clear();
+            output_table.buffer_output_views.clear();
 
             img_ver_read_handles.clear();
             img_ver_write_handles.clear();
             buf_ver_read_handles.clear();
             buf_ver_write_handles.clear();
 
+            compile_trace.next("setup");
+
             // Step A: Invoke Setup Functions
             // Invoke setup function to collect resource usages so that we
             // can compute the topology of pass and execute succeeding phases.
             // - Read: graph.passes, graph.setup_funcs
-            // - Write: meta_table, image_read_deps, image_write_deps, buffer_read_deps, buffer_write_deps
-
-            pass_setup_context setup_ctx{.meta_table        = &meta_table,
-                                         .image_read_deps   = &image_read_deps,
-                                         .image_write_deps  = &image_write_deps,
-                                         .buffer_read_deps  = &buffer_read_deps,
-                                         .buffer_write_deps = &buffer_write_deps,
-                                         .output_table      = &output_table,
-                                         .current_pass      = 0};
+            // - Write: meta_table, image_read_deps, image_write_deps, buffer_read_deps, buffer_write_deps, *_history_read_deps,
+            //          image_overwrite_deps
+
+            pass_setup_context setup_ctx{.meta_table               = &meta_table,
+                                         .image_read_deps          = &image_read_deps,
+                                         .image_write_deps         = &image_write_deps,
+                                         .buffer_read_deps         = &buffer_read_deps,
+                                         .buffer_write_deps        = &buffer_write_deps,
+                                         .output_table             = &output_table,
+                                         .current_pass             = 0,
+                                         .image_history_read_deps  = &image_history_read_deps,
+                                         .buffer_history_read_deps = &buffer_history_read_deps,
+                                         .image_overwrite_deps     = &image_overwrite_deps};
+            auto replay_reads = [](const read_dependency& from, read_dependency& to, pass_handle pass)
+            {
+                const auto begin  = from.begins[pass];
+                const auto length = from.lengthes[pass];
+                to.read_list.insert(to.read_list.end(), from.read_list.begin() + begin, from.read_list.begin() + begin + length);
+                to.usage_bits.insert(to.usage_bits.end(), from.usage_bits.begin() + begin, from.usage_bits.begin() + begin + length);
+                to.lengthes[pass] = length;
+            };
+            auto replay_writes = [](const write_dependency& from, write_dependency& to, pass_handle pass)
+            {
+                const auto begin  = from.begins[pass];
+                const auto length = from.lengthes[pass];
+                to.write_list.insert(to.write_list.end(), from.write_list.begin() + begin, from.write_list.begin() + begin + length);
+                to.usage_bits.insert(to.usage_bits.end(), from.usage_bits.begin() + begin, from.usage_bits.begin() + begin + length);
+                to.lengthes[pass] = length;
+            };
+
+            meta_table.begin_declarations();
             for (size_t i = 0; i < pass_count; i++)
             {
                 setup_ctx.current_pass = graph.passes[i];
@@ -119,14 +656,129 @@ namespace render_graph
                 image_write_deps.begins[setup_ctx.current_pass]  = static_cast<pass_handle>(image_write_deps.write_list.size());
                 buffer_read_deps.begins[setup_ctx.current_pass]  = static_cast<pass_handle>(buffer_read_deps.read_list.size());
                 buffer_write_deps.begins[setup_ctx.current_pass] = static_cast<pass_handle>(buffer_write_deps.write_list.size());
+                image_history_read_deps.begins[setup_ctx.current_pass]  = static_cast<pass_handle>(image_history_read_deps.read_list.size());
+                buffer_history_read_deps.begins[setup_ctx.current_pass] = static_cast<pass_handle>(buffer_history_read_deps.read_list.size());
+                image_overwrite_deps.begins[setup_ctx.current_pass]     = static_cast<pass_handle>(image_overwrite_deps.write_list.size());
+
+                auto& record                    = pass_records[setup_ctx.current_pass];
+                const auto image_output_begin  = static_cast<uint32_t>(output_table.image_outputs.size());
+                const auto buffer_output_begin = static_cast<uint32_t>(output_table.buffer_outputs.size());
+
+                if (pass_dirty_flags[setup_ctx.current_pass] || !record.valid)
+                {
+                    edited_passes.push_back(setup_ctx.current_pass);
+                    if (last_compile_replayed_setup && record.valid)
+                    {
+                        const auto& image_outputs  = previous.output_table.image_outputs;
+                        const auto& buffer_outputs = previous.output_table.buffer_outputs;
+                        previous.edited_image_outputs.insert(previous.edited_image_outputs.end(),
+                                                             image_outputs.begin() + record.image_output_begin,
+                                                             image_outputs.begin() + record.image_output_begin + record.image_output_length);
+                        previous.edited_buffer_outputs.insert(previous.edited_buffer_outputs.end(),
+                                                              buffer_outputs.begin() + record.buffer_output_begin,
+                                                              buffer_outputs.begin() + record.buffer_output_begin + record.buffer_output_length);
+                    }
+                }
+
+                if (!graph.enabled[setup_ctx.current_pass])
+                {
+                    // Disabled or removed: declares nothing.
+                }
+                else if (replay_passes && record.valid && !pass_dirty_flags[setup_ctx.current_pass])
+                {
+                    const auto pass = setup_ctx.current_pass;
+                    replay_reads(previous.image_read_deps, image_read_deps, pass);
+                    replay_writes(previous.image_write_deps, image_write_deps, pass);
+                    replay_reads(previous.buffer_read_deps, buffer_read_deps, pass);
+                    replay_writes(previous.buffer_write_deps, buffer_write_deps, pass);
+                    replay_reads(previous.image_history_read_deps, image_history_read_deps, pass);
+                    replay_reads(previous.buffer_history_read_deps, buffer_history_read_deps, pass);
+                    replay_writes(previous.image_overwrite_deps, image_overwrite_deps, pass);
+
+                    const auto& image_outputs  = previous.output_table.image_outputs;
+                    const auto& buffer_outputs = previous.output_table.buffer_outputs;
+                    output_table.image_outputs.insert(output_table.image_outputs.end(),
+                                                      image_outputs.begin() + record.image_output_begin,
+                                                      image_outputs.begin() + record.image_output_begin + record.image_output_length);
+                    output_table.buffer_outputs.insert(output_table.buffer_outputs.end(),
+                                                       buffer_outputs.begin() + record.buffer_output_begin,
+                                                       buffer_outputs.begin() + record.buffer_output_begin + record.buffer_output_length);
+                    const auto& image_views  = previous.output_table.image_output_views;
+                    const auto& buffer_views = previous.output_table.buffer_output_views;
+                    output_table.image_output_views.insert(output_table.image_output_views.end(),
+                                                           image_views.begin() + record.image_output_begin,
+                                                           image_views.begin() + record.image_output_begin + record.image_output_length);
+                    output_table.buffer_output_views.insert(output_table.buffer_output_views.end(),
+                                                            buffer_views.begin() + record.buffer_output_begin,
+                                                            buffer_views.begin() + record.buffer_output_begin + record.buffer_output_length);
+
+                    for (const auto image : record.created_images)
+                    {
+                        meta_table.image_registry.touch(image);
+                    }
+                    for (const auto buffer : record.created_buffers)
+                    {
+                        meta_table.buffer_registry.touch(buffer);
+                    }
+                }
+                else
+                {
+                    auto& setup_func = graph.setup_funcs[i];
+                    setup_func(setup_ctx);
+                    last_setup_invocations++;
+                }
+
+                record.image_output_begin   = image_output_begin;
+                record.image_output_length  = static_cast<uint32_t>(output_table.image_outputs.size()) - image_output_begin;
+                record.buffer_output_begin  = buffer_output_begin;
+                record.buffer_output_length = static_cast<uint32_t>(output_table.buffer_outputs.size()) - buffer_output_begin;
+            }
+            // Resources no pass declared this time are released; their handles are recycled by later compiles.
+            meta_table.end_declarations();
+
+            // Record which resources each pass declared, for the next replay (retained mode, graph edits).
+            {
+                for (auto& record : pass_records)
+                {
+                    record.valid = true;
+                    record.created_images.clear();
+                    record.created_buffers.clear();
+                }
+                const auto& image_registry = meta_table.image_registry;
+                for (resource_handle image = 0; image < image_registry.handle_count(); image++)
+                {
+                    if (image_registry.is_alive(image) && image_registry.handle_passes[image] < pass_count)
+                    {
+                        pass_records[image_registry.handle_passes[image]].created_images.push_back(image);
+                    }
+                }
+                const auto& buffer_registry = meta_table.buffer_registry;
+                for (resource_handle buffer = 0; buffer < buffer_registry.handle_count(); buffer++)
+                {
+                    if (buffer_registry.is_alive(buffer) && buffer_registry.handle_passes[buffer] < pass_count)
+                    {
+                        pass_records[buffer_registry.handle_passes[buffer]].created_buffers.push_back(buffer);
+                    }
+                }
+            }
+            pass_dirty_flags.assign(pass_count, false);
+            compiled_structure = structural_hash();
 
-                auto setup_func = graph.setup_funcs[i];
-                setup_func(setup_ctx);
+            // Graph edits: Steps B-G only revisit what the edited passes touched.
+            last_compile_incremental = last_compile_replayed_setup && can_compile_edits(previous);
+            if (last_compile_incremental)
+            {
+                const bool ordered = compile_edits(previous, edited_passes, compile_trace);
+                compile_schedule(compile_trace, ordered);
+                return;
             }
+            build_resource_accessors();
 
             const auto image_count  = meta_table.image_metas.names.size();
             const auto buffer_count = meta_table.buffer_metas.names.size();
 
+            compile_trace.next("versioning");
+
             // Step B: Compute Resource Version (pack handle + version)
             // User-facing setup stage uses resource_handle only.
             // Here we derive a versioned view for internal compile-time algorithms.
@@ -227,6 +879,8 @@ namespace render_graph
                 }
             }
 
+            compile_trace.next("producer map");
+
             // Step C: Build resource-producer map (+ latest version per handle)
             // Build version -> producer lookup in a flat array (DOD/SoA friendly):
             // - offsets are indexed by resource_handle
@@ -322,6 +976,8 @@ namespace render_graph
                 }
             }
 
+            compile_trace.next("culling");
+
             // Step D: Culling
             // Analyze dependencies and mark passes as active/inactive
 
@@ -430,17 +1086,117 @@ namespace render_graph
                 return producer_lookup_table.buf_version_producers[idx];
             };
 
+            // Bitset engine: one row per pass, one bit per output root. A reader always comes after the producer
+            // of the version it reads (add order), so one reverse sweep ORs every live row into its producers.
+            // History reads may point at a later pass; if such a row changed, the sweep is repeated.
+            // Multi-view compiles always use it: the per-view subsets are read off the rows.
+            const bool use_liveness = bitset_liveness || view_count > 1;
+            if (use_liveness)
+            {
+                liveness.reset(pass_count, output_table.image_outputs.size() + output_table.buffer_outputs.size());
+
+                size_t root = 0;
+                for (const auto output_image : output_table.image_outputs)
+                {
+                    if (output_image < image_count)
+                    {
+                        const auto producer = get_image_producer(producer_lookup_table.latest_img[output_image]);
+                        if (producer < pass_count)
+                        {
+                            liveness.set(producer, root);
+                        }
+                    }
+                    root++;
+                }
+                for (const auto output_buffer : output_table.buffer_outputs)
+                {
+                    if (output_buffer < buffer_count)
+                    {
+                        const auto producer = get_buffer_producer(producer_lookup_table.latest_buf[output_buffer]);
+                        if (producer < pass_count)
+                        {
+                            liveness.set(producer, root);
+                        }
+                    }
+                    root++;
+                }
+
+                bool resweep = true;
+                while (resweep)
+                {
+                    resweep = false;
+                    for (auto i = pass_count; i-- > 0;)
+                    {
+                        const auto consumer = static_cast<pass_handle>(i);
+                        if (!liveness.any(consumer))
+                        {
+                            continue;
+                        }
+
+                        auto propagate = [&](pass_handle producer)
+                        {
+                            if (producer >= pass_count || producer == consumer)
+                            {
+                                return;
+                            }
+                            if (liveness.merge_into(producer, consumer) && producer > consumer)
+                            {
+                                resweep = true;
+                            }
+                        };
+
+                        const auto image_begin = image_read_deps.begins[consumer];
+                        for (auto j = image_begin; j < image_begin + image_read_deps.lengthes[consumer]; j++)
+                        {
+                            propagate(get_image_producer(img_ver_read_handles[j]));
+                        }
+                        const auto buffer_begin = buffer_read_deps.begins[consumer];
+                        for (auto j = buffer_begin; j < buffer_begin + buffer_read_deps.lengthes[consumer]; j++)
+                        {
+                            propagate(get_buffer_producer(buf_ver_read_handles[j]));
+                        }
+                        const auto image_history_begin = image_history_read_deps.begins[consumer];
+                        for (auto j = image_history_begin; j < image_history_begin + image_history_read_deps.lengthes[consumer]; j++)
+                        {
+                            const auto image = image_history_read_deps.read_list[j];
+                            if (image < image_count)
+                            {
+                                propagate(get_image_producer(producer_lookup_table.latest_img[image]));
+                            }
+                        }
+                        const auto buffer_history_begin = buffer_history_read_deps.begins[consumer];
+                        for (auto j = buffer_history_begin; j < buffer_history_begin + buffer_history_read_deps.lengthes[consumer]; j++)
+                        {
+                            const auto buffer = buffer_history_read_deps.read_list[j];
+                            if (buffer < buffer_count)
+                            {
+                                propagate(get_buffer_producer(producer_lookup_table.latest_buf[buffer]));
+                            }
+                        }
+                    }
+                }
+
+                for (pass_handle pass = 0; pass < pass_count; pass++)
+                {
+                    active_pass_flags[pass] = liveness.any(pass);
+                }
+            }
+            else
+            {
+                liveness.clear();
+            }
+
             // Seed roots from declared outputs (images/buffers)
             for (const auto output_image : output_table.image_outputs)
             {
-                if (output_image < image_count)
+                if (!use_liveness && output_image < image_count)
                 {
                     enqueue_image_producer(producer_lookup_table.latest_img[output_image]);
                 }
             }
             for (const auto output_buffer : output_table.buffer_outputs)
             {
-                if (output_buffer < buffer_count)
+                if (!use_liveness && output_buffer < buffer_count)
                 {
                     enqueue_buffer_producer(producer_lookup_table.latest_buf[output_buffer]);
                 }
@@ -471,103 +1227,57 @@ namespace render_graph
                         enqueue_buffer_producer(buf_ver_read_handles[j]);
                     }
                 }
-            }
 
-            // Step E: Validate Resource
-            // Validate graph correctness early and fail fast in debug builds.
-            // Typical checks:
-            // - Read-before-write on non-imported resources (producer == invalid_pass)
-            // - Out-of-range resource handles in deps lists
-            // - Empty output set (no roots) -> everything will be culled
-
-            // check outputs
-            assert((!output_table.image_outputs.empty() || !output_table.buffer_outputs.empty()) && "Error: No outputs declared");
-
-            // check read-before-write issues and out-of-range handles
-            for (size_t i = 0; i < pass_count; i++)
-            {
-                if (!active_pass_flags[i])
-                    continue;
-
-                const auto current_pass = graph.passes[i];
-                // image reads
+                // history reads: the previous frame's last version must be produced every frame.
                 {
-                    const auto read_begin  = image_read_deps.begins[current_pass];
-                    const auto read_length = image_read_deps.lengthes[current_pass];
+                    const auto read_begin  = image_history_read_deps.begins[current_pass];
+                    const auto read_length = image_history_read_deps.lengthes[current_pass];
                     for (auto j = read_begin; j < read_begin + read_length; j++)
                     {
-                        const auto image_handle = image_read_deps.read_list[j];
-                        if (image_handle >= image_count)
+                        const auto image = image_history_read_deps.read_list[j];
+                        if (image < image_count)
                         {
-                            assert(false && "Error: Image read out-of-range detected!");
-                        }
-
-                        const auto version_handle = img_ver_read_handles[j];
-                        const bool is_imported    = meta_table.image_metas.is_imported[image_handle];
-                        const auto producer       = get_image_producer(version_handle);
-
-                        if (version_handle == invalid_resource_version)
-                        {
-                            // next_version==0: no internal write happened before this read.
-                            // This is only legal for imported resources.
-                            assert(is_imported && "Error: Image read-before-write detected!");
-                        }
-                        else
-                        {
-                            assert((is_imported || producer != invalid_pass) && "Error: Image read-before-write detected!");
+                            enqueue_image_producer(producer_lookup_table.latest_img[image]);
                         }
                     }
                 }
-                // buffer reads
                 {
-                    const auto read_begin  = buffer_read_deps.begins[current_pass];
-                    const auto read_length = buffer_read_deps.lengthes[current_pass];
+                    const auto read_begin  = buffer_history_read_deps.begins[current_pass];
+                    const auto read_length = buffer_history_read_deps.lengthes[current_pass];
                     for (auto j = read_begin; j < read_begin + read_length; j++)
                     {
-                        const auto buffer_handle = buffer_read_deps.read_list[j];
-                        if (buffer_handle >= buffer_count)
-                        {
-                            assert(false && "Error: Buffer read out-of-range detected!");
-                        }
-
-                        const auto version_handle = buf_ver_read_handles[j];
-                        const bool is_imported    = meta_table.buffer_metas.is_imported[buffer_handle];
-                        const auto producer       = get_buffer_producer(version_handle);
-
-                        if (version_handle == invalid_resource_version)
-                        {
-                            assert(is_imported && "Error: Buffer read-before-write detected!");
-                        }
-                        else
+                        const auto buffer = buffer_history_read_deps.read_list[j];
+                        if (buffer < buffer_count)
                         {
-                            assert((is_imported || producer != invalid_pass) && "Error: Buffer read-before-write detected!");
+                            enqueue_buffer_producer(producer_lookup_table.latest_buf[buffer]);
                         }
                     }
                 }
-                // image writes
-                {
-                    const auto write_begin  = image_write_deps.begins[current_pass];
-                    const auto write_length = image_write_deps.lengthes[current_pass];
-                    for (auto j = write_begin; j < write_begin + write_length; j++)
-                    {
-                        const auto image_handle = image_write_deps.write_list[j];
-                        assert(image_handle < image_count && "Error: Image write out-of-range detected!");
-                        assert(img_ver_write_handles[j] != invalid_resource_version && "Error: Image write out-of-range detected!");
-                    }
-                }
-                // buffer writes
+            }
+
+            compile_trace.next("validation");
+
+            // Step E: Validate Resource
+            // Validate graph correctness early and fail fast in debug builds.
+            // Typical checks:
+            // - Read-before-write on non-imported resources (producer == invalid_pass)
+            // - Out-of-range resource handles in deps lists
+            // - Empty output set (no roots) -> everything will be culled
+
+            // check outputs
+            assert((!output_table.image_outputs.empty() || !output_table.buffer_outputs.empty()) && "Error: No outputs declared");
+
+            // check read-before-write issues and out-of-range handles
+            for (pass_handle pass = 0; pass < pass_count; pass++)
+            {
+                if (active_pass_flags[pass])
                 {
-                    const auto write_begin  = buffer_write_deps.begins[current_pass];
-                    const auto write_length = buffer_write_deps.lengthes[current_pass];
-                    for (auto j = write_begin; j < write_begin + write_length; j++)
-                    {
-                        const auto buffer_handle = buffer_write_deps.write_list[j];
-                        assert(buffer_handle < buffer_count && "Error: Buffer write out-of-range detected!");
-                        assert(buf_ver_write_handles[j] != invalid_resource_version && "Error: Buffer write out-of-range detected!");
-                    }
+                    validate_pass(pass);
                 }
             }
 
+            compile_trace.next("dag");
+
             // Step F: DAG Construction (Not yet implemented)
             // Build pass-to-pass edges based on read dependencies and producer lookup:
             // - For each live pass P and each resource R in P.read_list:
@@ -578,585 +1288,2885 @@ namespace render_graph
 
             // Forward adjacency (CSR): producer -> consumer.
             // We build edges for all active passes (already culled from declared outputs).
-            std::vector<std::vector<pass_handle>> outgoing(pass_count);
-            auto add_edge = [&](pass_handle from, pass_handle to)
+            // Besides read-after-write, every version orders its readers and its writer before the next live writer
+            // of the resource (write-after-read / write-after-write), so any topological order is a valid schedule.
+            std::vector<std::vector<dag_edge>> outgoing(pass_count);
+            for (pass_handle pass = 0; pass < pass_count; pass++)
             {
-                if (from == invalid_pass || to == invalid_pass)
-                {
-                    return;
-                }
-                if (from >= pass_count || to >= pass_count)
+                if (active_pass_flags[pass])
                 {
-                    return;
+                    add_pass_edges(pass, outgoing, nullptr);
                 }
-                if (from == to)
+            }
+            build_dag(outgoing);
+
+            compile_schedule(compile_trace);
+        }
+
+        // Declarations of the previous compile (replayed for clean passes) and, for graph edits, what Steps B-G
+        // derived from them (see compile_edits).
+        struct declaration_snapshot
+        {
+            read_dependency image_read_deps;
+            write_dependency image_write_deps;
+            read_dependency buffer_read_deps;
+            write_dependency buffer_write_deps;
+            read_dependency image_history_read_deps;
+            read_dependency buffer_history_read_deps;
+            write_dependency image_overwrite_deps;
+            struct output_table output_table;
+
+            std::vector<resource_version_handle> img_ver_read_handles;
+            std::vector<resource_version_handle> img_ver_write_handles;
+            std::vector<resource_version_handle> buf_ver_read_handles;
+            std::vector<resource_version_handle> buf_ver_write_handles;
+            version_producer_map producer_lookup_table;
+            std::vector<bool> active_pass_flags;
+            directed_acyclic_graph dag;
+            std::vector<pass_handle> sorted_passes;
+
+            // Outputs the edited passes declared before the edit.
+            std::vector<resource_handle> edited_image_outputs;
+            std::vector<resource_handle> edited_buffer_outputs;
+        };
+
+        // Whether compile_edits can update the previous compile: culling follows the version order only without
+        // history reads (their producers come later), and the liveness rows are not maintained.
+        [[nodiscard]] bool can_compile_edits(const declaration_snapshot& previous) const
+        {
+            if (bitset_liveness || view_count > 1)
+            {
+                return false;
+            }
+            if (!image_history_read_deps.read_list.empty() || !buffer_history_read_deps.read_list.empty())
+            {
+                return false;
+            }
+            const auto& previous_map = previous.producer_lookup_table;
+            if (previous_map.img_version_offsets.empty() || previous_map.buf_version_offsets.empty())
+            {
+                return false;
+            }
+            const auto previous_image_count  = previous_map.img_version_offsets.size() - 1;
+            const auto previous_buffer_count = previous_map.buf_version_offsets.size() - 1;
+            return image_accessors.size() == previous_image_count && buffer_accessors.size() == previous_buffer_count &&
+                   meta_table.image_metas.names.size() >= previous_image_count &&
+                   meta_table.buffer_metas.names.size() >= previous_buffer_count;
+        }
+
+        void build_resource_accessors()
+        {
+            const auto pass_count = graph.passes.size();
+            image_accessors.assign(meta_table.image_metas.names.size(), {});
+            buffer_accessors.assign(meta_table.buffer_metas.names.size(), {});
+            for (pass_handle pass = 0; pass < pass_count; pass++)
+            {
+                add_resource_accessor(image_accessors, image_read_deps.read_list, image_read_deps.begins[pass], image_read_deps.lengthes[pass], pass);
+                add_resource_accessor(image_accessors, image_write_deps.write_list, image_write_deps.begins[pass], image_write_deps.lengthes[pass], pass);
+                add_resource_accessor(buffer_accessors, buffer_read_deps.read_list, buffer_read_deps.begins[pass], buffer_read_deps.lengthes[pass], pass);
+                add_resource_accessor(buffer_accessors, buffer_write_deps.write_list, buffer_write_deps.begins[pass], buffer_write_deps.lengthes[pass], pass);
+            }
+        }
+
+        // Adds pass to the accessors of resources[begin, begin + length), keeping each list sorted and unique.
+        static void add_resource_accessor(std::vector<std::vector<pass_handle>>& accessors, const std::vector<resource_handle>& resources,
+                                          uint32_t begin, uint32_t length, pass_handle pass)
+        {
+            for (auto j = begin; j < begin + length; j++)
+            {
+                if (resources[j] >= accessors.size())
                 {
-                    return;
+                    continue;
                 }
-                if (!active_pass_flags[from] || !active_pass_flags[to])
+                auto& list     = accessors[resources[j]];
+                const auto pos = std::lower_bound(list.begin(), list.end(), pass);
+                if (pos == list.end() || *pos != pass)
                 {
-                    return;
+                    list.insert(pos, pass);
                 }
-                outgoing[from].push_back(to);
-            };
+            }
+        }
 
-            for (size_t i = 0; i < pass_count; i++)
+        static void remove_resource_accessor(std::vector<std::vector<pass_handle>>& accessors, const std::vector<resource_handle>& resources,
+                                             uint32_t begin, uint32_t length, pass_handle pass)
+        {
+            for (auto j = begin; j < begin + length; j++)
             {
-                const auto consumer_pass = graph.passes[i];
-                if (!active_pass_flags[consumer_pass])
+                if (resources[j] >= accessors.size())
                 {
                     continue;
                 }
+                auto& list     = accessors[resources[j]];
+                const auto pos = std::lower_bound(list.begin(), list.end(), pass);
+                if (pos != list.end() && *pos == pass)
+                {
+                    list.erase(pos);
+                }
+            }
+        }
 
-                // image read dependencies: producer(img_ver_read) -> consumer
+        // Steps B-G for graph edits (see Graph editing). Versions and producers are recomputed for the resources
+        // the edited passes declare before or after the edit (and resources created since the last compile), by
+        // walking their accessors; every other resource keeps its versions and producers. Culling flags are
+        // re-evaluated from the latest affected pass backwards, DAG edges are rebuilt among the passes using a
+        // resource that was affected or used by a pass whose flag changed, and those passes are placed into the
+        // previous topological order. The flat per-pass and per-resource tables are still re-laid out (copies),
+        // but nothing outside the affected passes is re-analyzed.
+        // Returns false if the previous order cannot be kept; Step G then sorts the whole DAG again.
+        bool compile_edits(declaration_snapshot& previous, const std::vector<pass_handle>& edited_passes, trace_stage& compile_trace)
+        {
+            const auto pass_count            = graph.passes.size();
+            const auto image_count           = meta_table.image_metas.names.size();
+            const auto buffer_count          = meta_table.buffer_metas.names.size();
+            const auto previous_pass_count   = previous.image_read_deps.begins.size();
+            const auto previous_image_count  = previous.producer_lookup_table.img_version_offsets.size() - 1;
+            const auto previous_buffer_count = previous.producer_lookup_table.buf_version_offsets.size() - 1;
+            const auto unaffected            = std::numeric_limits<uint32_t>::max();
+
+            compile_trace.next("versioning");
+
+            // Affected resources: index into affected_images/affected_buffers, or unaffected.
+            std::vector<uint32_t> image_affected_index(image_count, unaffected);
+            std::vector<uint32_t> buffer_affected_index(buffer_count, unaffected);
+            std::vector<resource_handle> affected_images;
+            std::vector<resource_handle> affected_buffers;
+            auto affect_image = [&](resource_handle image)
+            {
+                if (image < image_count && image_affected_index[image] == unaffected)
                 {
-                    const auto read_begin  = image_read_deps.begins[consumer_pass];
-                    const auto read_length = image_read_deps.lengthes[consumer_pass];
-                    for (auto j = read_begin; j < read_begin + read_length; j++)
-                    {
-                        const auto producer = get_image_producer(img_ver_read_handles[j]);
-                        add_edge(producer, consumer_pass);
-                    }
+                    image_affected_index[image] = static_cast<uint32_t>(affected_images.size());
+                    affected_images.push_back(image);
                 }
+            };
+            auto affect_buffer = [&](resource_handle buffer)
+            {
+                if (buffer < buffer_count && buffer_affected_index[buffer] == unaffected)
+                {
+                    buffer_affected_index[buffer] = static_cast<uint32_t>(affected_buffers.size());
+                    affected_buffers.push_back(buffer);
+                }
+            };
+            auto affect_images = [&](const std::vector<resource_handle>& images, size_t begin, size_t length)
+            {
+                for (auto j = begin; j < begin + length; j++)
+                {
+                    affect_image(images[j]);
+                }
+            };
+            auto affect_buffers = [&](const std::vector<resource_handle>& buffers, size_t begin, size_t length)
+            {
+                for (auto j = begin; j < begin + length; j++)
+                {
+                    affect_buffer(buffers[j]);
+                }
+            };
 
-                // buffer read dependencies: producer(buf_ver_read) -> consumer
+            std::vector<bool> edited(pass_count, false);
+            for (const auto pass : edited_passes)
+            {
+                edited[pass] = true;
+                if (pass < previous_pass_count)
                 {
-                    const auto read_begin  = buffer_read_deps.begins[consumer_pass];
-                    const auto read_length = buffer_read_deps.lengthes[consumer_pass];
-                    for (auto j = read_begin; j < read_begin + read_length; j++)
-                    {
-                        const auto producer = get_buffer_producer(buf_ver_read_handles[j]);
-                        add_edge(producer, consumer_pass);
-                    }
+                    const auto& reads  = previous.image_read_deps;
+                    const auto& writes = previous.image_write_deps;
+                    affect_images(reads.read_list, reads.begins[pass], reads.lengthes[pass]);
+                    affect_images(writes.write_list, writes.begins[pass], writes.lengthes[pass]);
+                    remove_resource_accessor(image_accessors, reads.read_list, reads.begins[pass], reads.lengthes[pass], pass);
+                    remove_resource_accessor(image_accessors, writes.write_list, writes.begins[pass], writes.lengthes[pass], pass);
+
+                    const auto& buffer_reads  = previous.buffer_read_deps;
+                    const auto& buffer_writes = previous.buffer_write_deps;
+                    affect_buffers(buffer_reads.read_list, buffer_reads.begins[pass], buffer_reads.lengthes[pass]);
+                    affect_buffers(buffer_writes.write_list, buffer_writes.begins[pass], buffer_writes.lengthes[pass]);
+                    remove_resource_accessor(buffer_accessors, buffer_reads.read_list, buffer_reads.begins[pass], buffer_reads.lengthes[pass], pass);
+                    remove_resource_accessor(buffer_accessors, buffer_writes.write_list, buffer_writes.begins[pass], buffer_writes.lengthes[pass], pass);
                 }
             }
-
-            dag.adjacency_list.clear();
-            dag.adjacency_begins.assign(static_cast<size_t>(pass_count) + 1, 0);
-            dag.in_degrees.assign(pass_count, 0);
-            dag.out_degrees.assign(pass_count, 0);
-
-            // De-duplicate edges per producer and compute degrees.
-            for (pass_handle pass = 0; pass < pass_count; pass++)
+            image_accessors.resize(image_count);
+            buffer_accessors.resize(buffer_count);
+            for (const auto pass : edited_passes)
             {
-                auto& list = outgoing[pass];
-                std::sort(list.begin(), list.end());
-                list.erase(std::unique(list.begin(), list.end()), list.end());
+                affect_images(image_read_deps.read_list, image_read_deps.begins[pass], image_read_deps.lengthes[pass]);
+                affect_images(image_write_deps.write_list, image_write_deps.begins[pass], image_write_deps.lengthes[pass]);
+                affect_buffers(buffer_read_deps.read_list, buffer_read_deps.begins[pass], buffer_read_deps.lengthes[pass]);
+                affect_buffers(buffer_write_deps.write_list, buffer_write_deps.begins[pass], buffer_write_deps.lengthes[pass]);
+                add_resource_accessor(image_accessors, image_read_deps.read_list, image_read_deps.begins[pass], image_read_deps.lengthes[pass], pass);
+                add_resource_accessor(image_accessors, image_write_deps.write_list, image_write_deps.begins[pass], image_write_deps.lengthes[pass], pass);
+                add_resource_accessor(buffer_accessors, buffer_read_deps.read_list, buffer_read_deps.begins[pass], buffer_read_deps.lengthes[pass], pass);
+                add_resource_accessor(buffer_accessors, buffer_write_deps.write_list, buffer_write_deps.begins[pass], buffer_write_deps.lengthes[pass], pass);
+
+                const auto& record = pass_records[pass];
+                affect_images(record.created_images, 0, record.created_images.size());
+                affect_buffers(record.created_buffers, 0, record.created_buffers.size());
+                affect_images(output_table.image_outputs, record.image_output_begin, record.image_output_length);
+                affect_buffers(output_table.buffer_outputs, record.buffer_output_begin, record.buffer_output_length);
             }
-            for (pass_handle from = 0; from < pass_count; from++)
+            affect_images(previous.edited_image_outputs, 0, previous.edited_image_outputs.size());
+            affect_buffers(previous.edited_buffer_outputs, 0, previous.edited_buffer_outputs.size());
+            for (auto image = static_cast<resource_handle>(previous_image_count); image < image_count; image++)
             {
-                dag.out_degrees[from] = static_cast<uint32_t>(outgoing[from].size());
-                for (const auto dst_pass : outgoing[from])
-                {
-                    dag.in_degrees[dst_pass]++;
-                }
+                affect_image(image);
             }
-
-            // Build CSR arrays.
-            uint32_t running = 0;
-            for (pass_handle from = 0; from < pass_count; from++)
+            for (auto buffer = static_cast<resource_handle>(previous_buffer_count); buffer < buffer_count; buffer++)
             {
-                dag.adjacency_begins[from] = running;
-                const auto& list           = outgoing[from];
-                dag.adjacency_list.insert(dag.adjacency_list.end(), list.begin(), list.end());
-                running = static_cast<uint32_t>(dag.adjacency_list.size());
+                affect_buffer(buffer);
             }
-            dag.adjacency_begins[pass_count] = running;
-
-            // Step G: Scheduling / Topological Order
-            // Compute execution order for live passes (Kahn's algorithm).
-            // This also validates that there are no cycles.
 
-            sorted_passes.clear();
-            sorted_passes.reserve(pass_count);
-            std::vector<uint32_t> in_degrees_copy = dag.in_degrees;
-            std::queue<pass_handle> zero_in_degree_queue;
-            for (pass_handle pass = 0; pass < pass_count; pass++)
+            // Step B: clean passes keep their versions (their declarations were replayed unchanged); accesses to
+            // affected resources are versioned again in pass order.
+            img_ver_read_handles.assign(image_read_deps.read_list.size(), invalid_resource_version);
+            img_ver_write_handles.assign(image_write_deps.write_list.size(), invalid_resource_version);
+            buf_ver_read_handles.assign(buffer_read_deps.read_list.size(), invalid_resource_version);
+            buf_ver_write_handles.assign(buffer_write_deps.write_list.size(), invalid_resource_version);
+            auto keep_versions = [](const std::vector<resource_version_handle>& from, uint32_t from_begin, uint32_t length,
+                                    std::vector<resource_version_handle>& to, uint32_t to_begin)
             {
-                if (active_pass_flags[pass] && in_degrees_copy[pass] == 0)
+                std::copy(from.begin() + from_begin, from.begin() + from_begin + length, to.begin() + to_begin);
+            };
+            for (pass_handle pass = 0; pass < std::min(pass_count, previous_pass_count); pass++)
+            {
+                if (edited[pass])
                 {
-                    zero_in_degree_queue.push(pass);
+                    continue;
                 }
+                keep_versions(previous.img_ver_read_handles, previous.image_read_deps.begins[pass], image_read_deps.lengthes[pass],
+                              img_ver_read_handles, image_read_deps.begins[pass]);
+                keep_versions(previous.img_ver_write_handles, previous.image_write_deps.begins[pass], image_write_deps.lengthes[pass],
+                              img_ver_write_handles, image_write_deps.begins[pass]);
+                keep_versions(previous.buf_ver_read_handles, previous.buffer_read_deps.begins[pass], buffer_read_deps.lengthes[pass],
+                              buf_ver_read_handles, buffer_read_deps.begins[pass]);
+                keep_versions(previous.buf_ver_write_handles, previous.buffer_write_deps.begins[pass], buffer_write_deps.lengthes[pass],
+                              buf_ver_write_handles, buffer_write_deps.begins[pass]);
             }
 
-            while (!zero_in_degree_queue.empty())
+            // Returns the producers of resource's versions, in version order.
+            auto version_resource = [](resource_handle resource, const std::vector<pass_handle>& accessors, const read_dependency& reads,
+                                       const write_dependency& writes, std::vector<resource_version_handle>& read_versions,
+                                       std::vector<resource_version_handle>& write_versions)
             {
-                const auto current_pass = zero_in_degree_queue.front();
-                zero_in_degree_queue.pop();
-
-                sorted_passes.push_back(current_pass);
-
-                const auto begin = dag.adjacency_begins[current_pass];
-                const auto end   = dag.adjacency_begins[current_pass + 1];
-                for (auto j = begin; j < end; j++)
+                std::vector<pass_handle> producers;
+                for (const auto pass : accessors)
                 {
-                    const auto dst_pass = dag.adjacency_list[j];
-                    in_degrees_copy[dst_pass]--;
-                    if (in_degrees_copy[dst_pass] == 0)
+                    const auto next_version = static_cast<version_handle>(producers.size());
+                    for (auto j = reads.begins[pass]; j < reads.begins[pass] + reads.lengthes[pass]; j++)
                     {
-                        zero_in_degree_queue.push(dst_pass);
+                        if (reads.read_list[j] == resource)
+                        {
+                            read_versions[j] = next_version == 0 ? invalid_resource_version : pack(resource, static_cast<version_handle>(next_version - 1));
+                        }
+                    }
+                    for (auto j = writes.begins[pass]; j < writes.begins[pass] + writes.lengthes[pass]; j++)
+                    {
+                        if (writes.write_list[j] == resource)
+                        {
+                            write_versions[j] = pack(resource, static_cast<version_handle>(producers.size()));
+                            producers.push_back(pass);
+                        }
                     }
                 }
+                return producers;
+            };
+            std::vector<std::vector<pass_handle>> affected_image_producers(affected_images.size());
+            for (size_t k = 0; k < affected_images.size(); k++)
+            {
+                const auto image            = affected_images[k];
+                affected_image_producers[k] = version_resource(image, image_accessors[image], image_read_deps, image_write_deps,
+                                                               img_ver_read_handles, img_ver_write_handles);
             }
-            const size_t active_pass_count = static_cast<size_t>(std::count(active_pass_flags.begin(), active_pass_flags.end(), true));
-            assert(sorted_passes.size() == active_pass_count && "Error: Cycle detected in render graph!");
-
-            // Step H: Lifetime Analysis & Aliasing
-            // For each resource version, compute first/last use across the scheduled pass order.
-            // Use this to:
-            // - allocate transient resources from pools
-            // - alias memory for non-overlapping lifetimes
-
-            // 1. Build Pass Index Map (Handle -> Execution Order Index)
-            // We need strictly monotonic indices to compare lifetimes correctly.
-            std::vector<uint32_t> sorted_pass_indices(pass_count, 0);
-            for (uint32_t i = 0; i < sorted_passes.size(); i++)
+            std::vector<std::vector<pass_handle>> affected_buffer_producers(affected_buffers.size());
+            for (size_t k = 0; k < affected_buffers.size(); k++)
             {
-                sorted_pass_indices[sorted_passes[i]] = i;
+                const auto buffer            = affected_buffers[k];
+                affected_buffer_producers[k] = version_resource(buffer, buffer_accessors[buffer], buffer_read_deps, buffer_write_deps,
+                                                                buf_ver_read_handles, buf_ver_write_handles);
             }
 
-            resource_lifetimes.clear();
-            resource_lifetimes.image_first_used_pass.assign(image_count, invalid_pass);
-            resource_lifetimes.image_last_used_pass.assign(image_count, 0);
-            resource_lifetimes.buffer_first_used_pass.assign(buffer_count, invalid_pass);
-            resource_lifetimes.buffer_last_used_pass.assign(buffer_count, 0);
+            compile_trace.next("producer map");
 
-            // 2. Compute Lifetimes (using execution indices)
-            for (const auto pass : sorted_passes)
+            // Step C: same layout as a full compile; unaffected resources copy their producers.
+            auto build_producers = [&](size_t resource_count, size_t previous_resource_count, const std::vector<uint32_t>& affected_index,
+                                       const std::vector<std::vector<pass_handle>>& affected_producers, const std::vector<uint32_t>& previous_offsets,
+                                       const std::vector<pass_handle>& previous_producers, std::vector<uint32_t>& offsets,
+                                       std::vector<pass_handle>& producers, std::vector<resource_version_handle>& latest)
             {
-                const uint32_t actual_pass_index = sorted_pass_indices[pass];
-
-                auto update_lifetime = [&](std::vector<uint32_t>& firsts, std::vector<uint32_t>& lasts, resource_handle res, size_t count)
+                offsets.assign(resource_count + 1, 0);
+                latest.assign(resource_count, invalid_resource_version);
+                producers.clear();
+                for (resource_handle resource = 0; resource < resource_count; resource++)
                 {
-                    if (res >= count) return;
-                    if (firsts[res] == invalid_pass)
+                    offsets[resource] = static_cast<uint32_t>(producers.size());
+                    if (affected_index[resource] != unaffected)
                     {
-                        firsts[res] = actual_pass_index;
+                        const auto& list = affected_producers[affected_index[resource]];
+                        producers.insert(producers.end(), list.begin(), list.end());
                     }
-                    lasts[res] = actual_pass_index;
-                };
-
-                // image reads
-                {
-                    const auto read_begin  = image_read_deps.begins[pass];
-                    const auto read_length = image_read_deps.lengthes[pass];
-                    for (auto j = read_begin; j < read_begin + read_length; j++)
+                    else if (resource < previous_resource_count)
                     {
-                        update_lifetime(resource_lifetimes.image_first_used_pass, resource_lifetimes.image_last_used_pass, image_read_deps.read_list[j], image_count);
+                        producers.insert(producers.end(), previous_producers.begin() + previous_offsets[resource],
+                                         previous_producers.begin() + previous_offsets[resource + 1]);
                     }
-                }
-                // image writes
-                {
-                    const auto write_begin  = image_write_deps.begins[pass];
-                    const auto write_length = image_write_deps.lengthes[pass];
-                    for (auto j = write_begin; j < write_begin + write_length; j++)
+                    const auto version_count = static_cast<uint32_t>(producers.size()) - offsets[resource];
+                    if (version_count > 0)
                     {
-                        update_lifetime(resource_lifetimes.image_first_used_pass, resource_lifetimes.image_last_used_pass, image_write_deps.write_list[j], image_count);
+                        latest[resource] = pack(resource, static_cast<version_handle>(version_count - 1));
                     }
                 }
-                // buffer reads
+                offsets[resource_count] = static_cast<uint32_t>(producers.size());
+            };
+            build_producers(image_count, previous_image_count, image_affected_index, affected_image_producers,
+                            previous.producer_lookup_table.img_version_offsets, previous.producer_lookup_table.img_version_producers,
+                            producer_lookup_table.img_version_offsets, producer_lookup_table.img_version_producers, producer_lookup_table.latest_img);
+            build_producers(buffer_count, previous_buffer_count, buffer_affected_index, affected_buffer_producers,
+                            previous.producer_lookup_table.buf_version_offsets, previous.producer_lookup_table.buf_version_producers,
+                            producer_lookup_table.buf_version_offsets, producer_lookup_table.buf_version_producers, producer_lookup_table.latest_buf);
+
+            compile_trace.next("culling");
+
+            // Step D: a pass is live if it writes the latest version of a declared output or a version a live pass
+            // reads. Readers come after the producer of the version they read, so evaluating candidates from the
+            // latest pass backwards sees final consumer flags; a pass whose flag changed re-queues its producers.
+            liveness.clear();
+            active_pass_flags = std::move(previous.active_pass_flags);
+            active_pass_flags.resize(pass_count, false);
+
+            std::vector<bool> output_images(image_count, false);
+            std::vector<bool> output_buffers(buffer_count, false);
+            for (const auto image : output_table.image_outputs)
+            {
+                if (image < image_count)
                 {
-                    const auto read_begin  = buffer_read_deps.begins[pass];
-                    const auto read_length = buffer_read_deps.lengthes[pass];
-                    for (auto j = read_begin; j < read_begin + read_length; j++)
-                    {
-                        update_lifetime(resource_lifetimes.buffer_first_used_pass, resource_lifetimes.buffer_last_used_pass, buffer_read_deps.read_list[j], buffer_count);
-                    }
+                    output_images[image] = true;
                 }
-                // buffer writes
+            }
+            for (const auto buffer : output_table.buffer_outputs)
+            {
+                if (buffer < buffer_count)
                 {
-                    const auto write_begin  = buffer_write_deps.begins[pass];
-                    const auto write_length = buffer_write_deps.lengthes[pass];
-                    for (auto j = write_begin; j < write_begin + write_length; j++)
-                    {
-                        update_lifetime(resource_lifetimes.buffer_first_used_pass, resource_lifetimes.buffer_last_used_pass, buffer_write_deps.write_list[j], buffer_count);
-                    }
+                    output_buffers[buffer] = true;
                 }
             }
 
-            // 3. Aliasing (Greedy First-Fit)
-            // Group resources that can share memory (transient & non-overlapping).
-            physical_resource_metas.clear();
-            
-            auto is_overlapping = [](uint32_t start_a, uint32_t end_a, uint32_t start_b, uint32_t end_b)
-            {
-                return std::max(start_a, start_b) <= std::min(end_a, end_b);
-            };
-
-            // Images
+            auto writes_live_version = [&](pass_handle pass, const write_dependency& writes, const std::vector<resource_version_handle>& write_versions,
+                                           const read_dependency& reads, const std::vector<resource_version_handle>& read_versions,
+                                           const std::vector<std::vector<pass_handle>>& accessors, const std::vector<bool>& outputs,
+                                           const std::vector<resource_version_handle>& latest)
             {
-                // Stores intervals for each unique resource: unique_id -> vector<{start, end}>
-                std::vector<std::vector<std::pair<uint32_t, uint32_t>>> life_intervals;
-                
-                // Resize mapping table
-                physical_resource_metas.handle_to_physical_img_id.assign(image_count, invalid_resource);
-
-                for (resource_handle img = 0; img < image_count; img++)
+                for (auto j = writes.begins[pass]; j < writes.begins[pass] + writes.lengthes[pass]; j++)
                 {
-                    const auto first = resource_lifetimes.image_first_used_pass[img];
-                    const auto last  = resource_lifetimes.image_last_used_pass[img];
-
-                    // Skip unused
-                    if (first == invalid_pass) continue;
-
-                    // Imported resources cannot be aliased (they are external)
-                    // We assign them a unique ID but don't merge them.
-                    if (meta_table.image_metas.is_imported[img])
+                    const auto version = write_versions[j];
+                    if (version == invalid_resource_version)
                     {
-                        const auto unique_id = static_cast<resource_handle>(physical_resource_metas.physical_image_meta.size());
-                        physical_resource_metas.physical_image_meta.push_back(img);
-                        physical_resource_metas.handle_to_physical_img_id[img] = unique_id;
-                        // We don't track intervals for imported resources as we don't manage their memory
-                        life_intervals.emplace_back(); 
                         continue;
                     }
-
-                    bool assigned = false;
-                    for (size_t u = 0; u < life_intervals.size(); u++)
+                    const auto resource = unpack_to_resource(version);
+                    if (outputs[resource] && latest[resource] == version)
                     {
-                        // Skip if this unique resource slot is for an imported resource (empty intervals)
-                        if (life_intervals[u].empty()) continue;
-
-                        // Check 1: Compatibility (Format, Size, etc.)
-                        // For now, we require strict equality of meta.
-                        const auto rep_img = physical_resource_metas.physical_image_meta[u];
-                        if (!meta_table.image_metas.is_compatible(rep_img, img)) continue;
-
-                        // Check 2: Overlap
-                        bool overlaps = false;
-                        for (const auto& interval : life_intervals[u])
+                        return true;
+                    }
+                    const auto& users = accessors[resource];
+                    for (auto it = std::upper_bound(users.begin(), users.end(), pass); it != users.end(); ++it)
+                    {
+                        const auto reader = *it;
+                        if (!active_pass_flags[reader])
                         {
-                            if (is_overlapping(first, last, interval.first, interval.second))
-                            {
-                                overlaps = true;
-                                break;
-                            }
+                            continue;
                         }
-
-                        if (!overlaps)
+                        for (auto k = reads.begins[reader]; k < reads.begins[reader] + reads.lengthes[reader]; k++)
                         {
-                            life_intervals[u].emplace_back(first, last);
-                            physical_resource_metas.handle_to_physical_img_id[img] = static_cast<resource_handle>(u);
-                            assigned = true;
-                            break;
+                            if (read_versions[k] == version)
+                            {
+                                return true;
+                            }
                         }
                     }
+                }
+                return false;
+            };
+            auto is_live = [&](pass_handle pass)
+            {
+                if (!graph.enabled[pass])
+                {
+                    return false;
+                }
+                return writes_live_version(pass, image_write_deps, img_ver_write_handles, image_read_deps, img_ver_read_handles, image_accessors,
+                                           output_images, producer_lookup_table.latest_img) ||
+                       writes_live_version(pass, buffer_write_deps, buf_ver_write_handles, buffer_read_deps, buf_ver_read_handles, buffer_accessors,
+                                           output_buffers, producer_lookup_table.latest_buf);
+            };
 
-                    if (!assigned)
-                    {
-                        const auto unique_id = static_cast<resource_handle>(physical_resource_metas.physical_image_meta.size());
-                        physical_resource_metas.physical_image_meta.push_back(img);
-                        physical_resource_metas.handle_to_physical_img_id[img] = unique_id;
-                        life_intervals.push_back({{first, last}});
-                    }
+            std::priority_queue<pass_handle> culling_worklist; // latest pass first
+            std::vector<bool> queued(pass_count, false);
+            auto enqueue_pass = [&](pass_handle pass)
+            {
+                if (pass < pass_count && !queued[pass])
+                {
+                    queued[pass] = true;
+                    culling_worklist.push(pass);
                 }
+            };
+            for (const auto pass : edited_passes)
+            {
+                enqueue_pass(pass);
             }
-
-            // Buffers
+            for (const auto image : affected_images)
             {
-                std::vector<std::vector<std::pair<uint32_t, uint32_t>>> life_intervals;
-                physical_resource_metas.handle_to_physical_buf_id.assign(buffer_count, invalid_resource);
-
-                for (resource_handle buf = 0; buf < buffer_count; buf++)
+                for (const auto pass : image_accessors[image])
                 {
-                    const auto first = resource_lifetimes.buffer_first_used_pass[buf];
-                    const auto last  = resource_lifetimes.buffer_last_used_pass[buf];
-
-                    if (first == invalid_pass) continue;
-
-                    if (meta_table.buffer_metas.is_imported[buf])
-                    {
-                        const auto unique_id = static_cast<resource_handle>(physical_resource_metas.physical_buffer_meta.size());
-                        physical_resource_metas.physical_buffer_meta.push_back(buf);
-                        physical_resource_metas.handle_to_physical_buf_id[buf] = unique_id;
-                        life_intervals.emplace_back();
-                        continue;
-                    }
-
-                    bool assigned = false;
-                    for (size_t u = 0; u < life_intervals.size(); u++)
-                    {
-                        if (life_intervals[u].empty()) continue;
-
-                        // Check Compatibility
-                        const auto rep_buf = physical_resource_metas.physical_buffer_meta[u];
-                        if (!meta_table.buffer_metas.is_compatible(rep_buf, buf)) continue;
-
-                        bool overlaps = false;
-                        for (const auto& interval : life_intervals[u])
-                        {
-                            if (is_overlapping(first, last, interval.first, interval.second))
-                            {
-                                overlaps = true;
-                                break;
-                            }
-                        }
-
-                        if (!overlaps)
-                        {
-                            life_intervals[u].emplace_back(first, last);
-                            physical_resource_metas.handle_to_physical_buf_id[buf] = static_cast<resource_handle>(u);
-                            assigned = true;
-                            break;
-                        }
-                    }
-
-                    if (!assigned)
-                    {
-                        const auto unique_id = static_cast<resource_handle>(physical_resource_metas.physical_buffer_meta.size());
-                        physical_resource_metas.physical_buffer_meta.push_back(buf);
-                        physical_resource_metas.handle_to_physical_buf_id[buf] = unique_id;
-                        life_intervals.push_back({{first, last}});
-                    }
+                    enqueue_pass(pass);
                 }
             }
-
-            // Step I: Build Synchronization Plan  (Barriers)
-            // Build an API-agnostic per-pass barrier list based on scheduled order.
-
-            per_pass_barriers.clear();
-            per_pass_barriers.resize_passes(pass_count);
-
-            // Scratch per-pass AoS; we will flatten into per_pass_barrier (CSR + SoA) afterwards.
-            std::vector<std::vector<barrier_op>> scratch(pass_count);
-
-            struct last_use
+            for (const auto buffer : affected_buffers)
             {
-                resource_handle logical   = 0;
-                uint32_t usage_bits       = 0;
-                pipeline_domain domain    = pipeline_domain::any;
-                access_type access        = access_type::read;
-                bool valid                = false;
-            };
-
-            const auto invalid_physical = invalid_resource;
-            std::vector<last_use> last_img_use(physical_resource_metas.physical_image_meta.size());
-            std::vector<last_use> last_buf_use(physical_resource_metas.physical_buffer_meta.size());
+                for (const auto pass : buffer_accessors[buffer])
+                {
+                    enqueue_pass(pass);
+                }
+            }
 
-            auto to_access = [](bool has_read, bool has_write) -> access_type
+            std::vector<pass_handle> visited_passes;
+            std::vector<pass_handle> changed_passes;
+            while (!culling_worklist.empty())
             {
-                if (has_read && has_write) return access_type::read_write;
-                if (has_write) return access_type::write;
-                return access_type::read;
-            };
+                const auto pass = culling_worklist.top();
+                culling_worklist.pop();
+                visited_passes.push_back(pass);
 
-            auto needs_uav_like = [](resource_kind kind, uint32_t usage_bits) -> bool
-            {
-                if (kind == resource_kind::image)
+                const bool live = is_live(pass);
+                if (live == active_pass_flags[pass])
                 {
-                    return (usage_bits & static_cast<uint32_t>(image_usage::STORAGE)) != 0;
+                    continue;
                 }
-                return (usage_bits & static_cast<uint32_t>(buffer_usage::STORAGE_BUFFER)) != 0;
-            };
+                active_pass_flags[pass] = live;
+                changed_passes.push_back(pass);
+                for (auto j = image_read_deps.begins[pass]; j < image_read_deps.begins[pass] + image_read_deps.lengthes[pass]; j++)
+                {
+                    enqueue_pass(image_producer(img_ver_read_handles[j]));
+                }
+                for (auto j = buffer_read_deps.begins[pass]; j < buffer_read_deps.begins[pass] + buffer_read_deps.lengthes[pass]; j++)
+                {
+                    enqueue_pass(buffer_producer(buf_ver_read_handles[j]));
+                }
+            }
 
-            auto insert_barrier = [&](pass_handle pass,
-                                    resource_kind kind,
-                                    resource_handle logical,
-                                    resource_handle physical,
-                                    access_type desired_access,
-                                    uint32_t desired_usage_bits)
+            compile_trace.next("validation");
+
+            // Step E: only the re-evaluated passes changed.
+            assert((!output_table.image_outputs.empty() || !output_table.buffer_outputs.empty()) && "Error: No outputs declared");
+            for (const auto pass : visited_passes)
             {
-                // validate physical id
-                if (physical == invalid_physical) return;
+                if (active_pass_flags[pass])
+                {
+                    validate_pass(pass);
+                }
+            }
 
-                // get last use record
-                auto& last_vec = (kind == resource_kind::image) ? last_img_use : last_buf_use;
-                if (physical >= last_vec.size()) return;
-                auto& last = last_vec[physical];
+            compile_trace.next("dag");
 
-                // if this physical id was previously used by a different logical resource, insert an aliasing barrier.
-                if (last.valid && last.logical != logical)
+            // Step F: an edge only changes if a resource behind it was affected or is used by a pass whose flag
+            // changed; every user of such a resource gets its edges among the other rebuilt passes generated again.
+            // Edges with an endpoint outside come from untouched resources only and are kept.
+            std::vector<bool> rebuilt(pass_count, false);
+            std::vector<pass_handle> rebuilt_passes;
+            auto rebuild_pass = [&](pass_handle pass)
+            {
+                if (!rebuilt[pass])
                 {
-                    barrier_op op;
-                    op.type         = barrier_op_type::aliasing;
-                    op.kind         = kind;
-                    op.logical      = logical;
-                    op.prev_logical = last.logical;
-                    op.physical     = physical;
-                    scratch[pass].push_back(op);
+                    rebuilt[pass] = true;
+                    rebuilt_passes.push_back(pass);
                 }
-
-                // if state/usage changed across passes, insert a transition op.
-                // note: backends decide what 'transition' means (Vk layout+barrier, D3D12 state transition, etc.).
-                if (last.valid)
+            };
+            auto rebuild_users = [&](const std::vector<std::vector<pass_handle>>& accessors, const std::vector<resource_handle>& resources,
+                                     size_t begin, size_t length)
+            {
+                for (auto j = begin; j < begin + length; j++)
                 {
-                    const bool changed = (last.usage_bits != desired_usage_bits) || (last.access != desired_access) || (last.domain != pipeline_domain::any);
-                    if (changed)
+                    if (resources[j] < accessors.size())
                     {
-                        barrier_op op;
-                        op.type          = barrier_op_type::transition;
-                        op.kind          = kind;
-                        op.logical       = logical;
-                        op.physical      = physical;
-                        op.src_domain    = last.domain;
-                        op.dst_domain    = pipeline_domain::any;
-                        op.src_access    = last.access;
-                        op.dst_access    = desired_access;
-                        op.src_usage_bits = last.usage_bits;
-                        op.dst_usage_bits = desired_usage_bits;
-                        scratch[pass].push_back(op);
+                        for (const auto pass : accessors[resources[j]])
+                        {
+                            rebuild_pass(pass);
+                        }
                     }
+                }
+            };
+            for (const auto pass : edited_passes)
+            {
+                rebuild_pass(pass);
+            }
+            rebuild_users(image_accessors, affected_images, 0, affected_images.size());
+            rebuild_users(buffer_accessors, affected_buffers, 0, affected_buffers.size());
+            for (const auto pass : changed_passes)
+            {
+                rebuild_users(image_accessors, image_read_deps.read_list, image_read_deps.begins[pass], image_read_deps.lengthes[pass]);
+                rebuild_users(image_accessors, image_write_deps.write_list, image_write_deps.begins[pass], image_write_deps.lengthes[pass]);
+                rebuild_users(buffer_accessors, buffer_read_deps.read_list, buffer_read_deps.begins[pass], buffer_read_deps.lengthes[pass]);
+                rebuild_users(buffer_accessors, buffer_write_deps.write_list, buffer_write_deps.begins[pass], buffer_write_deps.lengthes[pass]);
+            }
 
-                    // UAV-like ordering: write -> (read/write) on storage resources.
-                    if (last.access != access_type::read && needs_uav_like(kind, desired_usage_bits))
+            std::vector<std::vector<dag_edge>> outgoing(pass_count);
+            const auto& previous_dag = previous.dag;
+            const auto previous_dag_passes = previous_dag.adjacency_begins.empty() ? size_t{0} : previous_dag.adjacency_begins.size() - 1;
+            for (pass_handle from = 0; from < std::min(pass_count, previous_dag_passes); from++)
+            {
+                for (auto j = previous_dag.adjacency_begins[from]; j < previous_dag.adjacency_begins[from + 1]; j++)
+                {
+                    const auto to = previous_dag.adjacency_list[j];
+                    if (!rebuilt[from] || !rebuilt[to])
                     {
-                        barrier_op op;
-                        op.type     = barrier_op_type::uav;
-                        op.kind     = kind;
-                        op.logical  = logical;
-                        op.physical = physical;
-                        scratch[pass].push_back(op);
+                        outgoing[from].push_back(dag_edge{.to = to, .kinds = previous_dag.edge_kinds[j]});
                     }
                 }
-                
-                // Update last use info
-                last.valid      = true;
-                last.logical    = logical;
-                last.access     = desired_access;
-                last.domain     = pipeline_domain::any;
-                last.usage_bits = desired_usage_bits;
-            };
-
-            // Walk scheduled passes and build barriers for all resources they touch.
-            for (const auto pass : sorted_passes)
+            }
+            for (const auto pass : rebuilt_passes)
             {
-                // Images used by this pass
+                if (active_pass_flags[pass])
                 {
-                    std::unordered_map<resource_handle, std::pair<bool, bool>> rw; // logical -> {read, write}
-                    std::unordered_map<resource_handle, uint32_t> usage;
+                    add_pass_edges(pass, outgoing, &rebuilt);
+                }
+            }
+            build_dag(outgoing);
+
+            // Step G (order only): kept passes stay in their previous order; each rebuilt pass goes after its kept
+            // predecessors and before its kept successors, rebuilt passes among themselves in Kahn order.
+            std::vector<pass_handle> kept_order;
+            std::vector<uint32_t> kept_positions(pass_count, 0);
+            kept_order.reserve(previous.sorted_passes.size());
+            for (const auto pass : previous.sorted_passes)
+            {
+                if (!rebuilt[pass])
+                {
+                    kept_positions[pass] = static_cast<uint32_t>(kept_order.size());
+                    kept_order.push_back(pass);
+                }
+            }
 
-                    const auto r_begin  = image_read_deps.begins[pass];
-                    const auto r_len    = image_read_deps.lengthes[pass];
-                    for (auto j = r_begin; j < r_begin + r_len; j++)
+            // after: number of kept passes that must precede; before: position of the first kept successor.
+            std::vector<uint32_t> after(pass_count, 0);
+            std::vector<uint32_t> before(pass_count, static_cast<uint32_t>(kept_order.size()));
+            std::vector<uint32_t> pending(pass_count, 0);
+            for (pass_handle from = 0; from < pass_count; from++)
+            {
+                for (auto j = dag.adjacency_begins[from]; j < dag.adjacency_begins[from + 1]; j++)
+                {
+                    const auto to = dag.adjacency_list[j];
+                    if (rebuilt[from] && rebuilt[to])
                     {
-                        const auto logical = image_read_deps.read_list[j];
-                        rw[logical].first  = true;
-                        usage[logical] |= image_read_deps.usage_bits[j];
+                        pending[to]++;
                     }
-
-                    const auto w_begin = image_write_deps.begins[pass];
-                    const auto w_len   = image_write_deps.lengthes[pass];
-                    for (auto j = w_begin; j < w_begin + w_len; j++)
+                    else if (rebuilt[to])
                     {
-                        const auto logical  = image_write_deps.write_list[j];
-                        rw[logical].second  = true;
-                        usage[logical] |= image_write_deps.usage_bits[j];
+                        after[to] = std::max(after[to], kept_positions[from] + 1);
                     }
-
-                    for (const auto& [logical, flags] : rw)
+                    else if (rebuilt[from])
                     {
-                        const auto physical = (logical < physical_resource_metas.handle_to_physical_img_id.size())
-                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_img_id[logical])
-                                                  : invalid_physical;
-                        insert_barrier(pass, resource_kind::image, logical, physical, to_access(flags.first, flags.second), usage[logical]);
+                        before[from] = std::min(before[from], kept_positions[to]);
                     }
                 }
+            }
 
-                // Buffers used by this pass
+            std::queue<pass_handle> ready_passes;
+            size_t active_rebuilt_count = 0;
+            for (const auto pass : rebuilt_passes)
+            {
+                if (active_pass_flags[pass])
                 {
-                    std::unordered_map<resource_handle, std::pair<bool, bool>> rw; // logical -> {read, write}
-                    std::unordered_map<resource_handle, uint32_t> usage;
-
-                    const auto r_begin  = buffer_read_deps.begins[pass];
-                    const auto r_len    = buffer_read_deps.lengthes[pass];
-                    for (auto j = r_begin; j < r_begin + r_len; j++)
+                    active_rebuilt_count++;
+                    if (pending[pass] == 0)
                     {
-                        const auto logical = buffer_read_deps.read_list[j];
-                        rw[logical].first  = true;
-                        usage[logical] |= buffer_read_deps.usage_bits[j];
+                        ready_passes.push(pass);
                     }
-
-                    const auto w_begin = buffer_write_deps.begins[pass];
-                    const auto w_len   = buffer_write_deps.lengthes[pass];
-                    for (auto j = w_begin; j < w_begin + w_len; j++)
+                }
+            }
+            std::vector<pass_handle> placed;
+            placed.reserve(active_rebuilt_count);
+            while (!ready_passes.empty())
+            {
+                const auto pass = ready_passes.front();
+                ready_passes.pop();
+                if (after[pass] > before[pass])
+                {
+                    return false; // kept passes have to be reordered around this one
+                }
+                placed.push_back(pass);
+                for (auto j = dag.adjacency_begins[pass]; j < dag.adjacency_begins[pass + 1]; j++)
+                {
+                    const auto to = dag.adjacency_list[j];
+                    if (!rebuilt[to])
                     {
-                        const auto logical = buffer_write_deps.write_list[j];
-                        rw[logical].second = true;
-                        usage[logical] |= buffer_write_deps.usage_bits[j];
+                        continue;
                     }
-
-                    for (const auto& [logical, flags] : rw)
+                    after[to] = std::max(after[to], after[pass]);
+                    if (--pending[to] == 0)
                     {
-                        const auto physical = (logical < physical_resource_metas.handle_to_physical_buf_id.size())
-                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_buf_id[logical])
-                                                  : invalid_physical;
-                        insert_barrier(pass, resource_kind::buffer, logical, physical, to_access(flags.first, flags.second), usage[logical]);
+                        ready_passes.push(to);
                     }
                 }
             }
-
-            // Flatten scratch into per_pass_barrier (CSR + SoA).
-            uint32_t barrier_running = 0;
-            for (pass_handle pass = 0; pass < pass_count; pass++)
+            if (placed.size() != active_rebuilt_count)
             {
-                per_pass_barriers.pass_begins[pass]  = barrier_running;
-                per_pass_barriers.pass_lengths[pass] = static_cast<uint32_t>(scratch[pass].size());
-                barrier_running += per_pass_barriers.pass_lengths[pass];
+                return false; // cycle: reported by Step G
             }
-            per_pass_barriers.pass_begins[pass_count] = barrier_running;
 
-            per_pass_barriers.resize_ops(barrier_running);
-
-            for (pass_handle pass = 0; pass < pass_count; pass++)
+            std::stable_sort(placed.begin(), placed.end(), [&](pass_handle a, pass_handle b) { return after[a] < after[b]; });
+            sorted_passes.clear();
+            sorted_passes.reserve(kept_order.size() + placed.size());
+            size_t next_placed = 0;
+            for (uint32_t position = 0; position <= kept_order.size(); position++)
             {
-                const auto base = per_pass_barriers.pass_begins[pass];
-                const auto len  = per_pass_barriers.pass_lengths[pass];
-                for (uint32_t i = 0; i < len; i++)
+                while (next_placed < placed.size() && after[placed[next_placed]] == position)
                 {
-                    const auto& op = scratch[pass][i];
-                    const auto idx = base + i;
-
-                    per_pass_barriers.types[idx] = op.type;
-                    per_pass_barriers.kinds[idx] = op.kind;
-                    per_pass_barriers.logicals[idx] = op.logical;
-                    per_pass_barriers.physicals[idx] = op.physical;
-                    per_pass_barriers.src_domains[idx] = op.src_domain;
-                    per_pass_barriers.dst_domains[idx] = op.dst_domain;
-                    per_pass_barriers.src_accesses[idx] = op.src_access;
-                    per_pass_barriers.dst_accesses[idx] = op.dst_access;
-                    per_pass_barriers.src_usage_bits[idx] = op.src_usage_bits;
-                    per_pass_barriers.dst_usage_bits[idx] = op.dst_usage_bits;
-                    per_pass_barriers.prev_logicals[idx] = op.prev_logical;
+                    sorted_passes.push_back(placed[next_placed++]);
+                }
+                if (position < kept_order.size())
+                {
+                    sorted_passes.push_back(kept_order[position]);
                 }
             }
+            return true;
+        }
 
+        // Outgoing edge while Step F collects the edges of each pass (merged by build_dag).
+        struct dag_edge
+        {
+            pass_handle to = 0;
+            uint8_t kinds  = 0;
+        };
 
-            // Step J: Physical Resource Allocation (Not yet implemented)
-            // Create actual GPU resources for live, non-imported resources.
-            // - Filter out culled passes and unused resources
-            // - Imported resources: do not create; expect bind_imported_* later (frame loop)
-            // - Call backend to create/realize resources (possibly from pools)
+        // Producer of a version in producer_lookup_table (invalid_pass if the version was never written).
+        [[nodiscard]] pass_handle image_producer(resource_version_handle version) const
+        {
+            return version_producer(producer_lookup_table.img_version_offsets, producer_lookup_table.img_version_producers, version);
+        }
 
-            if (backend != nullptr)
-            {
+        [[nodiscard]] pass_handle buffer_producer(resource_version_handle version) const
+        {
+            return version_producer(producer_lookup_table.buf_version_offsets, producer_lookup_table.buf_version_producers, version);
+        }
+
+        static pass_handle version_producer(const std::vector<uint32_t>& offsets, const std::vector<pass_handle>& producers,
+                                            resource_version_handle version)
+        {
+            if (version == invalid_resource_version)
+            {
+                return std::numeric_limits<pass_handle>::max();
+            }
+            const auto resource = unpack_to_resource(version);
+            if (static_cast<size_t>(resource) + 1 >= offsets.size())
+            {
+                return std::numeric_limits<pass_handle>::max();
+            }
+            const auto idx = static_cast<uint32_t>(offsets[resource] + unpack_to_version(version));
+            if (idx >= offsets[resource + 1])
+            {
+                return std::numeric_limits<pass_handle>::max();
+            }
+            return producers[idx];
+        }
+
+        // Step E checks of one live pass: read-before-write, out-of-range handles, history reads.
+        void validate_pass(pass_handle current_pass) const
+        {
+            [[maybe_unused]] const auto image_count  = meta_table.image_metas.names.size();
+            [[maybe_unused]] const auto buffer_count = meta_table.buffer_metas.names.size();
+            [[maybe_unused]] const auto invalid_pass = std::numeric_limits<pass_handle>::max();
+
+            // image reads
+            {
+                const auto read_begin  = image_read_deps.begins[current_pass];
+                const auto read_length = image_read_deps.lengthes[current_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto image_handle = image_read_deps.read_list[j];
+                    if (image_handle >= image_count)
+                    {
+                        assert(false && "Error: Image read out-of-range detected!");
+                    }
+
+                    const auto version_handle = img_ver_read_handles[j];
+                    const bool is_imported    = meta_table.image_metas.is_imported[image_handle];
+                    const auto producer       = image_producer(version_handle);
+
+                    if (version_handle == invalid_resource_version)
+                    {
+                        // next_version==0: no internal write happened before this read.
+                        // This is only legal for imported resources.
+                        assert(is_imported && "Error: Image read-before-write detected!");
+                    }
+                    else
+                    {
+                        assert((is_imported || producer != invalid_pass) && "Error: Image read-before-write detected!");
+                    }
+                }
+            }
+            // buffer reads
+            {
+                const auto read_begin  = buffer_read_deps.begins[current_pass];
+                const auto read_length = buffer_read_deps.lengthes[current_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto buffer_handle = buffer_read_deps.read_list[j];
+                    if (buffer_handle >= buffer_count)
+                    {
+                        assert(false && "Error: Buffer read out-of-range detected!");
+                    }
+
+                    const auto version_handle = buf_ver_read_handles[j];
+                    const bool is_imported    = meta_table.buffer_metas.is_imported[buffer_handle];
+                    const auto producer       = buffer_producer(version_handle);
+
+                    if (version_handle == invalid_resource_version)
+                    {
+                        assert(is_imported && "Error: Buffer read-before-write detected!");
+                    }
+                    else
+                    {
+                        assert((is_imported || producer != invalid_pass) && "Error: Buffer read-before-write detected!");
+                    }
+                }
+            }
+            // image writes
+            {
+                const auto write_begin  = image_write_deps.begins[current_pass];
+                const auto write_length = image_write_deps.lengthes[current_pass];
+                for (auto j = write_begin; j < write_begin + write_length; j++)
+                {
+                    const auto image_handle = image_write_deps.write_list[j];
+                    assert(image_handle < image_count && "Error: Image write out-of-range detected!");
+                    assert(img_ver_write_handles[j] != invalid_resource_version && "Error: Image write out-of-range detected!");
+                }
+            }
+            // buffer writes
+            {
+                const auto write_begin  = buffer_write_deps.begins[current_pass];
+                const auto write_length = buffer_write_deps.lengthes[current_pass];
+                for (auto j = write_begin; j < write_begin + write_length; j++)
+                {
+                    const auto buffer_handle = buffer_write_deps.write_list[j];
+                    assert(buffer_handle < buffer_count && "Error: Buffer write out-of-range detected!");
+                    assert(buf_ver_write_handles[j] != invalid_resource_version && "Error: Buffer write out-of-range detected!");
+                }
+            }
+            // history reads: must target a transient resource written every frame
+            {
+                const auto read_begin  = image_history_read_deps.begins[current_pass];
+                const auto read_length = image_history_read_deps.lengthes[current_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto image_handle = image_history_read_deps.read_list[j];
+                    assert(image_handle < image_count && "Error: Image history read out-of-range detected!");
+                    assert(!meta_table.image_metas.is_imported[image_handle] && "Error: Imported image used as history resource!");
+                    assert(producer_lookup_table.latest_img[image_handle] != invalid_resource_version && "Error: Image history read of a resource never written!");
+                }
+            }
+            {
+                const auto read_begin  = buffer_history_read_deps.begins[current_pass];
+                const auto read_length = buffer_history_read_deps.lengthes[current_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto buffer_handle = buffer_history_read_deps.read_list[j];
+                    assert(buffer_handle < buffer_count && "Error: Buffer history read out-of-range detected!");
+                    assert(!meta_table.buffer_metas.is_imported[buffer_handle] && "Error: Imported buffer used as history resource!");
+                    assert(producer_lookup_table.latest_buf[buffer_handle] != invalid_resource_version && "Error: Buffer history read of a resource never written!");
+                }
+            }
+        }
+
+        // Step F edges of one active pass: producer -> pass for its reads (read-after-write), pass -> next live
+        // writer for its reads (write-after-read), previous live writer -> pass for its writes (write-after-write).
+        // With rebuilt set, only edges between two rebuilt passes are added (see compile_edits).
+        void add_pass_edges(pass_handle consumer_pass, std::vector<std::vector<dag_edge>>& outgoing, const std::vector<bool>* rebuilt) const
+        {
+            const auto pass_count   = graph.passes.size();
+            const auto invalid_pass = std::numeric_limits<pass_handle>::max();
+
+            auto add_edge = [&](pass_handle from, pass_handle to, dependency_kind kind)
+            {
+                if (from == invalid_pass || to == invalid_pass)
+                {
+                    return;
+                }
+                if (from >= pass_count || to >= pass_count)
+                {
+                    return;
+                }
+                if (from == to)
+                {
+                    return;
+                }
+                if (!active_pass_flags[from] || !active_pass_flags[to])
+                {
+                    return;
+                }
+                if (rebuilt != nullptr && (!(*rebuilt)[from] || !(*rebuilt)[to]))
+                {
+                    return;
+                }
+                outgoing[from].push_back(dag_edge{.to = to, .kinds = static_cast<uint8_t>(kind)});
+            };
+
+            // Writer of the version after the one read (version 0 for reads of unwritten, e.g. imported, resources).
+            auto next_version_of = [](resource_version_handle read_version, resource_handle resource) -> resource_version_handle
+            {
+                if (read_version == invalid_resource_version)
+                {
+                    return pack(resource, 0);
+                }
+                return pack(unpack_to_resource(read_version), static_cast<version_handle>(unpack_to_version(read_version) + 1));
+            };
+            auto previous_version_of = [](resource_version_handle write_version) -> resource_version_handle
+            {
+                if (write_version == invalid_resource_version || unpack_to_version(write_version) == 0)
+                {
+                    return invalid_resource_version;
+                }
+                return pack(unpack_to_resource(write_version), static_cast<version_handle>(unpack_to_version(write_version) - 1));
+            };
+
+            // Nearest active writer from a version on (or before it): culled writers in between are skipped, so
+            // the live passes around them are still ordered.
+            auto next_live_writer = [&](resource_version_handle version, auto&& producer_of) -> pass_handle
+            {
+                for (auto writer = producer_of(version); writer != invalid_pass; writer = producer_of(version))
+                {
+                    if (active_pass_flags[writer])
+                    {
+                        return writer;
+                    }
+                    version = pack(unpack_to_resource(version), static_cast<version_handle>(unpack_to_version(version) + 1));
+                }
+                return invalid_pass;
+            };
+            auto previous_live_writer = [&](resource_version_handle write_version, auto&& producer_of) -> pass_handle
+            {
+                for (auto version = previous_version_of(write_version); version != invalid_resource_version; version = previous_version_of(version))
+                {
+                    const auto writer = producer_of(version);
+                    if (writer == invalid_pass || active_pass_flags[writer])
+                    {
+                        return writer;
+                    }
+                }
+                return invalid_pass;
+            };
+
+            const auto image_producer_of  = [this](resource_version_handle version) { return image_producer(version); };
+            const auto buffer_producer_of = [this](resource_version_handle version) { return buffer_producer(version); };
+
+            // image read dependencies: producer(img_ver_read) -> consumer -> next live writer
+            {
+                const auto read_begin  = image_read_deps.begins[consumer_pass];
+                const auto read_length = image_read_deps.lengthes[consumer_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto producer = image_producer(img_ver_read_handles[j]);
+                    add_edge(producer, consumer_pass, dependency_kind::read_after_write);
+                    const auto next_writer = next_live_writer(next_version_of(img_ver_read_handles[j], image_read_deps.read_list[j]), image_producer_of);
+                    add_edge(consumer_pass, next_writer, dependency_kind::write_after_read);
+                }
+            }
+
+            // buffer read dependencies: producer(buf_ver_read) -> consumer -> next live writer
+            {
+                const auto read_begin  = buffer_read_deps.begins[consumer_pass];
+                const auto read_length = buffer_read_deps.lengthes[consumer_pass];
+                for (auto j = read_begin; j < read_begin + read_length; j++)
+                {
+                    const auto producer = buffer_producer(buf_ver_read_handles[j]);
+                    add_edge(producer, consumer_pass, dependency_kind::read_after_write);
+                    const auto next_writer = next_live_writer(next_version_of(buf_ver_read_handles[j], buffer_read_deps.read_list[j]), buffer_producer_of);
+                    add_edge(consumer_pass, next_writer, dependency_kind::write_after_read);
+                }
+            }
+
+            // write dependencies: previous live writer -> consumer
+            {
+                const auto write_begin  = image_write_deps.begins[consumer_pass];
+                const auto write_length = image_write_deps.lengthes[consumer_pass];
+                for (auto j = write_begin; j < write_begin + write_length; j++)
+                {
+                    const auto previous_writer = previous_live_writer(img_ver_write_handles[j], image_producer_of);
+                    add_edge(previous_writer, consumer_pass, dependency_kind::write_after_write);
+                }
+            }
+            {
+                const auto write_begin  = buffer_write_deps.begins[consumer_pass];
+                const auto write_length = buffer_write_deps.lengthes[consumer_pass];
+                for (auto j = write_begin; j < write_begin + write_length; j++)
+                {
+                    const auto previous_writer = previous_live_writer(buf_ver_write_handles[j], buffer_producer_of);
+                    add_edge(previous_writer, consumer_pass, dependency_kind::write_after_write);
+                }
+            }
+        }
+
+        // Merges the collected edges of every pass (de-duplicated, hazard kinds OR-ed) into dag.
+        void build_dag(std::vector<std::vector<dag_edge>>& outgoing)
+        {
+            const auto pass_count = graph.passes.size();
+
+            dag.adjacency_list.clear();
+            dag.edge_kinds.clear();
+            dag.adjacency_begins.assign(static_cast<size_t>(pass_count) + 1, 0);
+            dag.in_degrees.assign(pass_count, 0);
+            dag.out_degrees.assign(pass_count, 0);
+
+            // De-duplicate edges per producer (merging their hazard kinds) and compute degrees.
+            for (pass_handle pass = 0; pass < pass_count; pass++)
+            {
+                auto& list = outgoing[pass];
+                std::sort(list.begin(), list.end(), [](const dag_edge& a, const dag_edge& b) { return a.to < b.to; });
+                size_t unique_count = 0;
+                for (const auto& e : list)
+                {
+                    if (unique_count > 0 && list[unique_count - 1].to == e.to)
+                    {
+                        list[unique_count - 1].kinds |= e.kinds;
+                        continue;
+                    }
+                    list[unique_count++] = e;
+                }
+                list.resize(unique_count);
+            }
+            for (pass_handle from = 0; from < pass_count; from++)
+            {
+                dag.out_degrees[from] = static_cast<uint32_t>(outgoing[from].size());
+                for (const auto& e : outgoing[from])
+                {
+                    dag.in_degrees[e.to]++;
+                }
+            }
+
+            // Build CSR arrays.
+            uint32_t running = 0;
+            for (pass_handle from = 0; from < pass_count; from++)
+            {
+                dag.adjacency_begins[from] = running;
+                for (const auto& e : outgoing[from])
+                {
+                    dag.adjacency_list.push_back(e.to);
+                    dag.edge_kinds.push_back(e.kinds);
+                }
+                running = static_cast<uint32_t>(dag.adjacency_list.size());
+            }
+            dag.adjacency_begins[pass_count] = running;
+        }
+
+        // Steps G-J over the declarations, versions and DAG of Steps A-F: schedule, lifetimes & aliasing, barriers
+        // and allocation. Also run on their own when only the measured costs changed since the last schedule
+        // (see costs_changed).
+        // ordered: sorted_passes already holds a topological order of the DAG (compile_edits).
+        void compile_schedule(trace_stage& compile_trace, bool ordered = false)
+        {
+            const auto pass_count       = graph.passes.size();
+            const auto invalid_pass     = std::numeric_limits<pass_handle>::max();
+            const auto invalid_resource = std::numeric_limits<resource_handle>::max();
+            const auto image_count      = meta_table.image_metas.names.size();
+            const auto buffer_count     = meta_table.buffer_metas.names.size();
+            scheduled_cost_revision     = measured_costs.revision;
+
+            compile_trace.next("scheduling");
+
+            // Step G: Scheduling / Topological Order
+            // Compute execution order for live passes (Kahn's algorithm).
+            // This also validates that there are no cycles.
+
+            std::vector<uint32_t> in_degrees_copy = dag.in_degrees;
+            if (!ordered)
+            {
+                sorted_passes.clear();
+                sorted_passes.reserve(pass_count);
+                std::queue<pass_handle> zero_in_degree_queue;
+                for (pass_handle pass = 0; pass < pass_count; pass++)
+                {
+                    if (active_pass_flags[pass] && in_degrees_copy[pass] == 0)
+                    {
+                        zero_in_degree_queue.push(pass);
+                    }
+                }
+
+                while (!zero_in_degree_queue.empty())
+                {
+                    const auto current_pass = zero_in_degree_queue.front();
+                    zero_in_degree_queue.pop();
+
+                    sorted_passes.push_back(current_pass);
+
+                    const auto begin = dag.adjacency_begins[current_pass];
+                    const auto end   = dag.adjacency_begins[current_pass + 1];
+                    for (auto j = begin; j < end; j++)
+                    {
+                        const auto dst_pass = dag.adjacency_list[j];
+                        in_degrees_copy[dst_pass]--;
+                        if (in_degrees_copy[dst_pass] == 0)
+                        {
+                            zero_in_degree_queue.push(dst_pass);
+                        }
+                    }
+                }
+            }
+            const size_t active_pass_count = static_cast<size_t>(std::count(active_pass_flags.begin(), active_pass_flags.end(), true));
+            assert(sorted_passes.size() == active_pass_count && "Error: Cycle detected in render graph!");
+
+            // Bottom level of every live pass, walking the topological order backwards.
+            auto pass_cost = [&](pass_handle pass) -> float
+            {
+                const auto* measured = measured_costs.find(pass_identity(pass));
+                return (measured != nullptr) ? *measured : graph.costs[pass];
+            };
+
+            std::vector<float> bottom_levels(pass_count, 0.0F);
+            critical_path_length = 0.0F;
+            for (auto it = sorted_passes.rbegin(); it != sorted_passes.rend(); ++it)
+            {
+                const auto pass = *it;
+                float longest   = 0.0F;
+                for (auto j = dag.adjacency_begins[pass]; j < dag.adjacency_begins[pass + 1]; j++)
+                {
+                    longest = std::max(longest, bottom_levels[dag.adjacency_list[j]]);
+                }
+                bottom_levels[pass]  = pass_cost(pass) + longest;
+                critical_path_length = std::max(critical_path_length, bottom_levels[pass]);
+            }
+
+            // List scheduling: among the ready passes, take the highest bottom level (lowest handle on ties).
+            if (critical_path_scheduling)
+            {
+                auto lower_priority = [&](pass_handle a, pass_handle b)
+                {
+                    if (bottom_levels[a] != bottom_levels[b])
+                    {
+                        return bottom_levels[a] < bottom_levels[b];
+                    }
+                    return a > b;
+                };
+                std::priority_queue<pass_handle, std::vector<pass_handle>, decltype(lower_priority)> ready_passes(lower_priority);
+
+                in_degrees_copy = dag.in_degrees;
+                for (const auto pass : sorted_passes)
+                {
+                    if (in_degrees_copy[pass] == 0)
+                    {
+                        ready_passes.push(pass);
+                    }
+                }
+
+                sorted_passes.clear();
+                while (!ready_passes.empty())
+                {
+                    const auto current_pass = ready_passes.top();
+                    ready_passes.pop();
+
+                    sorted_passes.push_back(current_pass);
+
+                    for (auto j = dag.adjacency_begins[current_pass]; j < dag.adjacency_begins[current_pass + 1]; j++)
+                    {
+                        const auto dst_pass = dag.adjacency_list[j];
+                        in_degrees_copy[dst_pass]--;
+                        if (in_degrees_copy[dst_pass] == 0)
+                        {
+                            ready_passes.push(dst_pass);
+                        }
+                    }
+                }
+                assert(sorted_passes.size() == active_pass_count && "Error: Cycle detected in render graph!");
+            }
+
+            // Transitive reduction: walk passes in reverse topological order with a reachability bit row per pass.
+            // Successors are visited in topological order, so an edge from -> to is redundant iff to is already
+            // reachable through an earlier successor.
+            dag.reduced_adjacency_list.clear();
+            dag.reduced_adjacency_begins.clear();
+            dag.reduced_in_degrees.clear();
+            if (transitive_reduction)
+            {
+                std::vector<uint32_t> order_index(pass_count, 0);
+                for (uint32_t i = 0; i < sorted_passes.size(); i++)
+                {
+                    order_index[sorted_passes[i]] = i;
+                }
+
+                liveness_matrix reachable;
+                reachable.reset(pass_count, pass_count);
+                std::vector<std::vector<pass_handle>> kept(pass_count);
+                std::vector<pass_handle> successors;
+                for (auto it = sorted_passes.rbegin(); it != sorted_passes.rend(); ++it)
+                {
+                    const auto from = *it;
+                    successors.assign(dag.adjacency_list.begin() + dag.adjacency_begins[from],
+                                      dag.adjacency_list.begin() + dag.adjacency_begins[from + 1]);
+                    std::sort(successors.begin(), successors.end(), [&](pass_handle a, pass_handle b) { return order_index[a] < order_index[b]; });
+
+                    for (const auto to : successors)
+                    {
+                        if (reachable.test(from, to))
+                        {
+                            continue;
+                        }
+                        kept[from].push_back(to);
+                        reachable.set(from, to);
+                        reachable.merge_into(from, to);
+                    }
+                    std::sort(kept[from].begin(), kept[from].end());
+                }
+
+                dag.reduced_adjacency_begins.assign(static_cast<size_t>(pass_count) + 1, 0);
+                dag.reduced_in_degrees.assign(pass_count, 0);
+                for (pass_handle from = 0; from < pass_count; from++)
+                {
+                    dag.reduced_adjacency_begins[from] = static_cast<uint32_t>(dag.reduced_adjacency_list.size());
+                    for (const auto to : kept[from])
+                    {
+                        dag.reduced_adjacency_list.push_back(to);
+                        dag.reduced_in_degrees[to]++;
+                    }
+                }
+                dag.reduced_adjacency_begins[pass_count] = static_cast<uint32_t>(dag.reduced_adjacency_list.size());
+            }
+
+            // Views: each view keeps the passes live for its outputs, in merged schedule order
+            // (a subsequence of a topological order is a topological order of the subgraph).
+            view_plans.assign(view_count > 1 ? view_count : 0, view_plan{});
+            for_each_parallel(static_cast<uint32_t>(view_plans.size()), [&](uint32_t view)
+            {
+                std::vector<size_t> roots;
+                const auto image_root_count = output_table.image_outputs.size();
+                for (size_t root = 0; root < image_root_count; root++)
+                {
+                    if ((output_table.image_output_views[root] & (1U << view)) != 0)
+                    {
+                        roots.push_back(root);
+                    }
+                }
+                for (size_t root = 0; root < output_table.buffer_outputs.size(); root++)
+                {
+                    if ((output_table.buffer_output_views[root] & (1U << view)) != 0)
+                    {
+                        roots.push_back(image_root_count + root);
+                    }
+                }
+                const auto output_set = liveness.make_output_set(roots);
+
+                auto& plan = view_plans[view];
+                plan.active_pass_flags.assign(pass_count, false);
+                for (const auto pass : sorted_passes)
+                {
+                    if (liveness.intersects(pass, output_set))
+                    {
+                        plan.active_pass_flags[pass] = true;
+                        plan.sorted_passes.push_back(pass);
+                    }
+                }
+            });
+
+            compile_trace.next("lifetimes & aliasing");
+
+            // Step H: Lifetime Analysis & Aliasing
+            // For each resource version, compute first/last use across the scheduled pass order.
+            // Use this to:
+            // - allocate transient resources from pools
+            // - alias memory for non-overlapping lifetimes
+
+            // 1. Build Pass Index Map (Handle -> Execution Order Index)
+            // We need strictly monotonic indices to compare lifetimes correctly.
+            std::vector<uint32_t> sorted_pass_indices(pass_count, 0);
+            for (uint32_t i = 0; i < sorted_passes.size(); i++)
+            {
+                sorted_pass_indices[sorted_passes[i]] = i;
+            }
+
+            resource_lifetimes.clear();
+            resource_lifetimes.image_first_used_pass.assign(image_count, invalid_pass);
+            resource_lifetimes.image_last_used_pass.assign(image_count, 0);
+            resource_lifetimes.buffer_first_used_pass.assign(buffer_count, invalid_pass);
+            resource_lifetimes.buffer_last_used_pass.assign(buffer_count, 0);
+
+            // 2. Compute Lifetimes (using execution indices)
+            for (const auto pass : sorted_passes)
+            {
+                const uint32_t actual_pass_index = sorted_pass_indices[pass];
+
+                auto update_lifetime = [&](std::vector<uint32_t>& firsts, std::vector<uint32_t>& lasts, resource_handle res, size_t count)
+                {
+                    if (res >= count) return;
+                    if (firsts[res] == invalid_pass)
+                    {
+                        firsts[res] = actual_pass_index;
+                    }
+                    lasts[res] = actual_pass_index;
+                };
+
+                // image reads
+                {
+                    const auto read_begin  = image_read_deps.begins[pass];
+                    const auto read_length = image_read_deps.lengthes[pass];
+                    for (auto j = read_begin; j < read_begin + read_length; j++)
+                    {
+                        update_lifetime(resource_lifetimes.image_first_used_pass, resource_lifetimes.image_last_used_pass, image_read_deps.read_list[j], image_count);
+                    }
+                }
+                // image writes
+                {
+                    const auto write_begin  = image_write_deps.begins[pass];
+                    const auto write_length = image_write_deps.lengthes[pass];
+                    for (auto j = write_begin; j < write_begin + write_length; j++)
+                    {
+                        update_lifetime(resource_lifetimes.image_first_used_pass, resource_lifetimes.image_last_used_pass, image_write_deps.write_list[j], image_count);
+                    }
+                }
+                // buffer reads
+                {
+                    const auto read_begin  = buffer_read_deps.begins[pass];
+                    const auto read_length = buffer_read_deps.lengthes[pass];
+                    for (auto j = read_begin; j < read_begin + read_length; j++)
+                    {
+                        update_lifetime(resource_lifetimes.buffer_first_used_pass, resource_lifetimes.buffer_last_used_pass, buffer_read_deps.read_list[j], buffer_count);
+                    }
+                }
+                // buffer writes
+                {
+                    const auto write_begin  = buffer_write_deps.begins[pass];
+                    const auto write_length = buffer_write_deps.lengthes[pass];
+                    for (auto j = write_begin; j < write_begin + write_length; j++)
+                    {
+                        update_lifetime(resource_lifetimes.buffer_first_used_pass, resource_lifetimes.buffer_last_used_pass, buffer_write_deps.write_list[j], buffer_count);
+                    }
+                }
+            }
+
+            // Declared outputs are consumed after the frame (present, readback, next frame),
+            // so their storage must stay intact until the end of the schedule.
+            std::vector<bool> is_output_image(image_count, false);
+            std::vector<bool> is_output_buffer(buffer_count, false);
+            for (const auto output_image : output_table.image_outputs)
+            {
+                if (output_image < image_count)
+                {
+                    is_output_image[output_image] = true;
+                }
+            }
+            for (const auto output_buffer : output_table.buffer_outputs)
+            {
+                if (output_buffer < buffer_count)
+                {
+                    is_output_buffer[output_buffer] = true;
+                }
+            }
+
+            // History resources (read_*_previous_frame by a live pass) are read by the next frame, so the current
+            // frame's contents must also survive until the end of the schedule. The previous frame's contents live
+            // in a different slot (see 5.), so they never constrain aliasing within this frame.
+            std::vector<bool> is_history_image(image_count, false);
+            std::vector<bool> is_history_buffer(buffer_count, false);
+            for (const auto pass : sorted_passes)
+            {
+                const auto image_begin  = image_history_read_deps.begins[pass];
+                const auto image_length = image_history_read_deps.lengthes[pass];
+                for (auto j = image_begin; j < image_begin + image_length; j++)
+                {
+                    if (image_history_read_deps.read_list[j] < image_count)
+                    {
+                        is_history_image[image_history_read_deps.read_list[j]] = true;
+                    }
+                }
+                const auto buffer_begin  = buffer_history_read_deps.begins[pass];
+                const auto buffer_length = buffer_history_read_deps.lengthes[pass];
+                for (auto j = buffer_begin; j < buffer_begin + buffer_length; j++)
+                {
+                    if (buffer_history_read_deps.read_list[j] < buffer_count)
+                    {
+                        is_history_buffer[buffer_history_read_deps.read_list[j]] = true;
+                    }
+                }
+            }
+            const auto frame_end_index = sorted_passes.empty() ? 0U : static_cast<uint32_t>(sorted_passes.size() - 1);
+
+            // 3. Aliasing (Greedy First-Fit)
+            // Group resources that can share memory (transient & non-overlapping).
+            // With stable_aliasing, the previous compile's logical -> physical mapping is used as a hint first:
+            // a resource keeps its previous physical id whenever that is still valid (compatible, no overlap),
+            // so small graph changes do not reshuffle unrelated resources. Ids left unclaimed by hints become
+            // holes (physical_*_meta == invalid_resource) that later resources may fill; backends skip them.
+            auto previous_img_mapping = std::move(physical_resource_metas.handle_to_physical_img_id);
+            auto previous_buf_mapping = std::move(physical_resource_metas.handle_to_physical_buf_id);
+            physical_resource_metas.clear();
+
+            auto is_overlapping = [](uint32_t start_a, uint32_t end_a, uint32_t start_b, uint32_t end_b)
+            {
+                return std::max(start_a, start_b) <= std::min(end_a, end_b);
+            };
+
+            auto assign_physical_ids = [&](size_t count,
+                                           const std::vector<pass_handle>& first_used,
+                                           const std::vector<pass_handle>& last_used,
+                                           const std::vector<bool>& persists,
+                                           const std::vector<bool>& is_imported,
+                                           const auto& is_compatible,
+                                           const std::vector<uint32_t>& previous,
+                                           bool use_hints,
+                                           std::vector<resource_handle>& physical_meta,
+                                           std::vector<uint32_t>& handle_to_physical) -> uint32_t
+            {
+                // Stores intervals for each physical id: physical id -> vector<{start, end}>.
+                // Imported ids and holes have none; imported ids are never shared.
+                std::vector<std::vector<std::pair<uint32_t, uint32_t>>> life_intervals;
+                std::vector<bool> is_imported_id;
+
+                handle_to_physical.assign(count, invalid_resource);
+
+                auto fits = [&](size_t u, resource_handle res, uint32_t first, uint32_t last)
+                {
+                    if (u >= physical_meta.size() || physical_meta[u] == invalid_resource)
+                    {
+                        return true;
+                    }
+                    if (is_imported_id[u] || is_imported[res])
+                    {
+                        return false;
+                    }
+
+                    // Check 1: Compatibility (Format, Size, etc.)
+                    // For now, we require strict equality of meta.
+                    if (!is_compatible(physical_meta[u], res))
+                    {
+                        return false;
+                    }
+
+                    // Check 2: Overlap
+                    for (const auto& interval : life_intervals[u])
+                    {
+                        if (is_overlapping(first, last, interval.first, interval.second))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+
+                auto place = [&](size_t u, resource_handle res, uint32_t first, uint32_t last)
+                {
+                    if (u >= physical_meta.size())
+                    {
+                        physical_meta.resize(u + 1, invalid_resource);
+                        life_intervals.resize(u + 1);
+                        is_imported_id.resize(u + 1, false);
+                    }
+                    if (physical_meta[u] == invalid_resource)
+                    {
+                        physical_meta[u] = res;
+                    }
+                    if (is_imported[res])
+                    {
+                        // We don't track intervals for imported resources as we don't manage their memory
+                        is_imported_id[u] = true;
+                    }
+                    else
+                    {
+                        life_intervals[u].emplace_back(first, last);
+                    }
+                    handle_to_physical[res] = static_cast<uint32_t>(u);
+                };
+
+                // Pass 1: keep previous physical ids where still valid.
+                for (resource_handle res = 0; use_hints && res < count && res < previous.size(); res++)
+                {
+                    const auto first = first_used[res];
+                    const auto last  = persists[res] ? frame_end_index : last_used[res];
+                    const auto hint  = previous[res];
+                    if (first == invalid_pass || hint == invalid_resource)
+                    {
+                        continue;
+                    }
+                    if (fits(hint, res, first, last))
+                    {
+                        place(hint, res, first, last);
+                    }
+                }
+
+                // Pass 2: greedy first-fit for everything else.
+                for (resource_handle res = 0; res < count; res++)
+                {
+                    const auto first = first_used[res];
+                    const auto last  = persists[res] ? frame_end_index : last_used[res];
+
+                    // Skip unused and already placed
+                    if (first == invalid_pass || handle_to_physical[res] != invalid_resource) continue;
+
+                    size_t target = physical_meta.size();
+                    if (!is_imported[res])
+                    {
+                        for (size_t u = 0; u < physical_meta.size(); u++)
+                        {
+                            if (fits(u, res, first, last))
+                            {
+                                target = u;
+                                break;
+                            }
+                        }
+                    }
+                    place(target, res, first, last);
+                }
+
+                // Trailing holes carry no resource.
+                while (!physical_meta.empty() && physical_meta.back() == invalid_resource)
+                {
+                    physical_meta.pop_back();
+                }
+
+                // Report mappings that changed for resources alive in both compiles.
+                uint32_t changed = 0;
+                for (resource_handle res = 0; res < count && res < previous.size(); res++)
+                {
+                    if (previous[res] != invalid_resource && handle_to_physical[res] != invalid_resource && previous[res] != handle_to_physical[res])
+                    {
+                        changed++;
+                    }
+                }
+                return changed;
+            };
+
+            // Images
+            std::vector<bool> persists_image(image_count, false);
+            for (resource_handle img = 0; img < image_count; img++)
+            {
+                persists_image[img] = is_output_image[img] || is_history_image[img];
+            }
+            physical_resource_metas.image_mapping_changes = assign_physical_ids(
+                image_count,
+                resource_lifetimes.image_first_used_pass,
+                resource_lifetimes.image_last_used_pass,
+                persists_image,
+                meta_table.image_metas.is_imported,
+                [&](resource_handle a, resource_handle b) { return meta_table.image_metas.is_compatible(a, b); },
+                previous_img_mapping,
+                stable_aliasing,
+                physical_resource_metas.physical_image_meta,
+                physical_resource_metas.handle_to_physical_img_id);
+
+            // Buffers
+            std::vector<bool> persists_buffer(buffer_count, false);
+            for (resource_handle buf = 0; buf < buffer_count; buf++)
+            {
+                persists_buffer[buf] = is_output_buffer[buf] || is_history_buffer[buf];
+            }
+            physical_resource_metas.buffer_mapping_changes = assign_physical_ids(
+                buffer_count,
+                resource_lifetimes.buffer_first_used_pass,
+                resource_lifetimes.buffer_last_used_pass,
+                persists_buffer,
+                meta_table.buffer_metas.is_imported,
+                [&](resource_handle a, resource_handle b) { return meta_table.buffer_metas.is_compatible(a, b); },
+                previous_buf_mapping,
+                stable_aliasing,
+                physical_resource_metas.physical_buffer_meta,
+                physical_resource_metas.handle_to_physical_buf_id);
+
+            // 4. Memoryless Classification
+            // A physical image is memoryless when all logical images mapped to it are transient,
+            // not declared as outputs or history, only ever declared (meta + every live access) as
+            // color/depth attachments, and first and last used by the same pass. Their contents never need
+            // to reach memory outside that render pass (e.g. MSAA color resolved in the pass, depth-only), so
+            // backends may use lazily-allocated memory. An attachment loaded by a later pass is stored in
+            // between (see attachment load/store ops) and stays backed by memory.
+            {
+                const uint32_t attachment_bits = static_cast<uint32_t>(image_usage::COLOR_ATTACHMENT) |
+                                                 static_cast<uint32_t>(image_usage::DEPTH_STENCIL_ATTACHMENT);
+
+                std::vector<bool> attachment_only(image_count, false);
+                for (resource_handle img = 0; img < image_count; img++)
+                {
+                    const auto meta_bits = static_cast<uint32_t>(meta_table.image_metas.usages[img]);
+                    attachment_only[img] = !meta_table.image_metas.is_imported[img] && !is_output_image[img] && !is_history_image[img] &&
+                                           (meta_bits & attachment_bits) != 0 && (meta_bits & ~attachment_bits) == 0 &&
+                                           resource_lifetimes.image_first_used_pass[img] == resource_lifetimes.image_last_used_pass[img];
+                }
+                for (const auto pass : sorted_passes)
+                {
+                    const auto read_begin  = image_read_deps.begins[pass];
+                    const auto read_length = image_read_deps.lengthes[pass];
+                    for (auto j = read_begin; j < read_begin + read_length; j++)
+                    {
+                        const auto image = image_read_deps.read_list[j];
+                        if (image < image_count && (image_read_deps.usage_bits[j] & ~attachment_bits) != 0)
+                        {
+                            attachment_only[image] = false;
+                        }
+                    }
+                    const auto write_begin  = image_write_deps.begins[pass];
+                    const auto write_length = image_write_deps.lengthes[pass];
+                    for (auto j = write_begin; j < write_begin + write_length; j++)
+                    {
+                        const auto image = image_write_deps.write_list[j];
+                        if (image < image_count && (image_write_deps.usage_bits[j] & ~attachment_bits) != 0)
+                        {
+                            attachment_only[image] = false;
+                        }
+                    }
+                }
+
+                physical_resource_metas.physical_image_memoryless.assign(physical_resource_metas.physical_image_meta.size(), true);
+                for (resource_handle img = 0; img < image_count; img++)
+                {
+                    const auto physical = physical_resource_metas.handle_to_physical_img_id[img];
+                    if (physical == invalid_resource)
+                    {
+                        continue;
+                    }
+                    if (!attachment_only[img])
+                    {
+                        physical_resource_metas.physical_image_memoryless[physical] = false;
+                    }
+                }
+            }
+
+            // 5. Frames-in-flight Replication
+            // Physical ids holding a declared output are read after the frame's passes (present, readback),
+            // possibly while the CPU already records the next frame: give them one slot per frame in flight.
+            // Physical ids holding a history resource always get one slot per frame of the ring (at least 2):
+            // frame f writes slot(f) while reading slot(f - 1).
+            // Everything else lives strictly within a frame and keeps a single shared slot; the barrier plan
+            // orders its first use in a frame after the previous frame's last use (see Step I).
+            frames_in_flight = std::max(frames_in_flight, 1U);
+            {
+                const bool has_history = std::find(is_history_image.begin(), is_history_image.end(), true) != is_history_image.end() ||
+                                         std::find(is_history_buffer.begin(), is_history_buffer.end(), true) != is_history_buffer.end();
+                physical_resource_metas.frames_in_flight = has_history ? std::max(frames_in_flight, 2U) : frames_in_flight;
+            }
+            {
+                const auto ring_size = physical_resource_metas.frames_in_flight;
+
+                auto build_frame_slots = [&](size_t physical_count,
+                                             const std::vector<uint32_t>& handle_to_physical,
+                                             const std::vector<bool>& is_output,
+                                             const std::vector<bool>& is_history,
+                                             const std::vector<bool>& is_imported,
+                                             std::vector<bool>& per_frame,
+                                             std::vector<bool>& history,
+                                             std::vector<uint32_t>& frame_slots,
+                                             std::vector<uint32_t>& slot_to_physical)
+                {
+                    per_frame.assign(physical_count, false);
+                    history.assign(physical_count, false);
+                    for (resource_handle logical = 0; logical < handle_to_physical.size(); logical++)
+                    {
+                        const auto physical = handle_to_physical[logical];
+                        if (physical == invalid_resource || is_imported[logical])
+                        {
+                            continue;
+                        }
+                        if (is_history[logical])
+                        {
+                            history[physical]   = true;
+                            per_frame[physical] = true;
+                        }
+                        if (is_output[logical] && frames_in_flight > 1)
+                        {
+                            per_frame[physical] = true;
+                        }
+                    }
+
+                    frame_slots.assign(physical_count * ring_size, 0);
+                    slot_to_physical.resize(physical_count);
+                    for (uint32_t physical = 0; physical < physical_count; physical++)
+                    {
+                        slot_to_physical[physical] = physical;
+                    }
+                    for (uint32_t physical = 0; physical < physical_count; physical++)
+                    {
+                        const auto base  = static_cast<size_t>(physical) * ring_size;
+                        frame_slots[base] = physical;
+                        for (uint32_t frame = 1; frame < ring_size; frame++)
+                        {
+                            if (per_frame[physical])
+                            {
+                                frame_slots[base + frame] = static_cast<uint32_t>(slot_to_physical.size());
+                                slot_to_physical.push_back(physical);
+                            }
+                            else
+                            {
+                                frame_slots[base + frame] = physical;
+                            }
+                        }
+                    }
+                };
+
+                build_frame_slots(physical_resource_metas.physical_image_meta.size(),
+                                  physical_resource_metas.handle_to_physical_img_id,
+                                  is_output_image,
+                                  is_history_image,
+                                  meta_table.image_metas.is_imported,
+                                  physical_resource_metas.physical_image_per_frame,
+                                  physical_resource_metas.physical_image_history,
+                                  physical_resource_metas.physical_image_frame_slots,
+                                  physical_resource_metas.image_slot_to_physical);
+                build_frame_slots(physical_resource_metas.physical_buffer_meta.size(),
+                                  physical_resource_metas.handle_to_physical_buf_id,
+                                  is_output_buffer,
+                                  is_history_buffer,
+                                  meta_table.buffer_metas.is_imported,
+                                  physical_resource_metas.physical_buffer_per_frame,
+                                  physical_resource_metas.physical_buffer_history,
+                                  physical_resource_metas.physical_buffer_frame_slots,
+                                  physical_resource_metas.buffer_slot_to_physical);
+            }
+
+            compile_trace.next("barriers");
+
+            // Attachment load/store ops
+            // For every attachment (COLOR/DEPTH_STENCIL usage) of a scheduled pass:
+            // - load:  LOAD if the pass reads it or an earlier scheduled pass wrote it, DONT_CARE if the pass declared
+            //          a full overwrite (overwrite_image) without reading it, CLEAR for the first write otherwise
+            // - store: STORE if imported, declared as output/history or used by a later pass; DONT_CARE on its last use
+            per_pass_attachments.clear();
+            per_pass_attachments.resize_passes(pass_count);
+            {
+                const uint32_t attachment_bits = static_cast<uint32_t>(image_usage::COLOR_ATTACHMENT) |
+                                                 static_cast<uint32_t>(image_usage::DEPTH_STENCIL_ATTACHMENT);
+
+                struct attachment_use
+                {
+                    resource_handle logical = 0;
+                    uint32_t usage_bits     = 0;
+                    bool read               = false;
+                    bool write              = false;
+                    bool overwrite          = false; // declared with overwrite_image
+                };
+                std::vector<std::vector<attachment_use>> attachment_scratch(pass_count);
+
+                auto find_use = [](std::vector<attachment_use>& uses, resource_handle logical) -> attachment_use&
+                {
+                    for (auto& use : uses)
+                    {
+                        if (use.logical == logical)
+                        {
+                            return use;
+                        }
+                    }
+                    uses.push_back(attachment_use{.logical = logical});
+                    return uses.back();
+                };
+
+                for (const auto pass : sorted_passes)
+                {
+                    auto& uses = attachment_scratch[pass];
+
+                    const auto read_begin  = image_read_deps.begins[pass];
+                    const auto read_length = image_read_deps.lengthes[pass];
+                    for (auto j = read_begin; j < read_begin + read_length; j++)
+                    {
+                        const auto image = image_read_deps.read_list[j];
+                        if (image >= image_count || (image_read_deps.usage_bits[j] & attachment_bits) == 0)
+                        {
+                            continue;
+                        }
+                        auto& use = find_use(uses, image);
+                        use.read  = true;
+                        use.usage_bits |= (image_read_deps.usage_bits[j] & attachment_bits);
+                    }
+
+                    const auto write_begin  = image_write_deps.begins[pass];
+                    const auto write_length = image_write_deps.lengthes[pass];
+                    for (auto j = write_begin; j < write_begin + write_length; j++)
+                    {
+                        const auto image = image_write_deps.write_list[j];
+                        if (image >= image_count || (image_write_deps.usage_bits[j] & attachment_bits) == 0)
+                        {
+                            continue;
+                        }
+                        auto& use = find_use(uses, image);
+                        use.write = true;
+                        use.usage_bits |= (image_write_deps.usage_bits[j] & attachment_bits);
+                    }
+
+                    const auto overwrite_begin  = image_overwrite_deps.begins[pass];
+                    const auto overwrite_length = image_overwrite_deps.lengthes[pass];
+                    for (auto j = overwrite_begin; j < overwrite_begin + overwrite_length; j++)
+                    {
+                        for (auto& use : uses)
+                        {
+                            use.overwrite = use.overwrite || use.logical == image_overwrite_deps.write_list[j];
+                        }
+                    }
+                }
+
+                uint32_t attachment_running = 0;
+                for (pass_handle pass = 0; pass < pass_count; pass++)
+                {
+                    per_pass_attachments.pass_begins[pass]  = attachment_running;
+                    per_pass_attachments.pass_lengths[pass] = static_cast<uint32_t>(attachment_scratch[pass].size());
+                    attachment_running += per_pass_attachments.pass_lengths[pass];
+                }
+                per_pass_attachments.pass_begins[pass_count] = attachment_running;
+                per_pass_attachments.resize_ops(attachment_running);
+
+                std::vector<bool> written(image_count, false); // Written by an earlier scheduled pass
+                for (const auto pass : sorted_passes)
+                {
+                    const auto pass_index = sorted_pass_indices[pass];
+                    const auto base       = per_pass_attachments.pass_begins[pass];
+                    const auto& uses      = attachment_scratch[pass];
+                    for (uint32_t i = 0; i < uses.size(); i++)
+                    {
+                        const auto& use = uses[i];
+                        const auto idx  = base + i;
+
+                        attachment_load_op load_op = attachment_load_op::load;
+                        if (!use.read && use.overwrite)
+                        {
+                            load_op = attachment_load_op::dont_care;
+                        }
+                        else if (!use.read && !written[use.logical])
+                        {
+                            load_op = attachment_load_op::clear;
+                        }
+
+                        const bool keep = meta_table.image_metas.is_imported[use.logical] || is_output_image[use.logical] || is_history_image[use.logical] ||
+                                          resource_lifetimes.image_last_used_pass[use.logical] > pass_index;
+
+                        per_pass_attachments.logicals[idx]   = use.logical;
+                        per_pass_attachments.physicals[idx]  = static_cast<resource_handle>(physical_resource_metas.handle_to_physical_img_id[use.logical]);
+                        per_pass_attachments.usage_bits[idx] = use.usage_bits;
+                        per_pass_attachments.load_ops[idx]   = load_op;
+                        per_pass_attachments.store_ops[idx]  = keep ? attachment_store_op::store : attachment_store_op::dont_care;
+                    }
+                    for (const auto& use : uses)
+                    {
+                        written[use.logical] = written[use.logical] || use.write;
+                    }
+                }
+            }
+
+            // Streaming execution: the physical mapping and attachment ops are final, so the backend can allocate
+            // and the final prefix of the schedule executes while the barrier plans below are built.
+            if (streaming_frame)
+            {
+                start_stream();
+            }
+
+            // Step I: Build Synchronization Plan  (Barriers)
+            // Build an API-agnostic per-pass barrier list based on scheduled order.
+
+            // The merged plan and the per-view plans are independent: plan 0 is the merged one, plan v + 1 view v.
+            const auto barrier_plan_count = merge_views ? 1U : static_cast<uint32_t>(view_plans.size()) + 1;
+            for_each_parallel(barrier_plan_count, [&](uint32_t plan_index)
+            {
+                if (plan_index == 0)
+                {
+                    build_barrier_plan(sorted_passes, per_pass_barriers);
+                    return;
+                }
+                auto& plan = view_plans[plan_index - 1];
+                build_barrier_plan(plan.sorted_passes, plan.per_pass_barriers);
+            });
+
+            compile_trace.next("allocation");
+
+            // Step J: Physical Resource Allocation (Not yet implemented)
+            // Create actual GPU resources for live, non-imported resources.
+            // - Filter out culled passes and unused resources
+            // - Imported resources: do not create; expect bind_imported_* later (frame loop)
+            // - Call backend to create/realize resources (possibly from pools)
+
+            if (backend != nullptr && !pipelined_compile && streamed_passes == 0)
+            {
                 backend->on_compile_resource_allocation(meta_table, physical_resource_metas);
+                backend->on_compile_attachment_ops(per_pass_attachments);
+            }
+
+            if (pipelined_compile)
+            {
+                save_plan(back_plan);
+            }
+
+            if (jobs != nullptr)
+            {
+                jobs->wait(stream_in_flight);
+            }
+        }
+
+        // Streaming execution, called in Step I: allocates, builds the barrier plan of the final prefix and
+        // starts executing it.
+        void start_stream()
+        {
+            const auto length = streamable_prefix_length();
+            if (length == 0)
+            {
+                return;
+            }
+
+            backend->on_compile_resource_allocation(meta_table, physical_resource_metas);
+            backend->on_compile_attachment_ops(per_pass_attachments);
+
+            // The prefix walk yields the same barriers as the full walk for these passes.
+            stream_schedule.assign(sorted_passes.begin(), sorted_passes.begin() + length);
+            build_barrier_plan(sorted_passes, stream_barriers, length);
+            streamed_passes = length;
+
+            RG_PROFILE_SCOPE("render_graph::execute");
+            begin_schedule_frame();
+            if (jobs == nullptr)
+            {
+                execute_passes(stream_schedule, 0, length, stream_barriers, meta_table, stream_frame_params);
+                return;
+            }
+            stream_in_flight.store(1, std::memory_order_release);
+            jobs->submit([this, length]
+                         {
+                             execute_passes(stream_schedule, 0, length, stream_barriers, meta_table, stream_frame_params);
+                             stream_in_flight.store(0, std::memory_order_release);
+                         });
+        }
+
+        // Number of leading passes of sorted_passes (at most stream_pass_limit) before the first pass that
+        // touches a history physical id, whose cross-frame ordering pairs both slots of the id. Shared ids do not
+        // end the prefix: the prefix walk takes their wrap-around source from the whole schedule.
+        [[nodiscard]] uint32_t streamable_prefix_length() const
+        {
+            auto is_history = [&](resource_kind kind, resource_handle logical) -> bool
+            {
+                const bool image        = kind == resource_kind::image;
+                const auto& to_physical = image ? physical_resource_metas.handle_to_physical_img_id : physical_resource_metas.handle_to_physical_buf_id;
+                const auto& history     = image ? physical_resource_metas.physical_image_history : physical_resource_metas.physical_buffer_history;
+                const auto& reps        = image ? physical_resource_metas.physical_image_meta : physical_resource_metas.physical_buffer_meta;
+                const auto& is_imported = image ? meta_table.image_metas.is_imported : meta_table.buffer_metas.is_imported;
+                if (logical >= to_physical.size() || to_physical[logical] >= history.size())
+                {
+                    return false;
+                }
+                const auto physical = to_physical[logical];
+                if (reps[physical] >= is_imported.size() || is_imported[reps[physical]])
+                {
+                    return false;
+                }
+                return history[physical];
+            };
+
+            auto touches = [&](pass_handle pass, resource_kind kind, const auto& begins, const auto& lengths, const auto& list) -> bool
+            {
+                for (auto j = begins[pass]; j < begins[pass] + lengths[pass]; j++)
+                {
+                    if (is_history(kind, list[j]))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            const auto limit = static_cast<uint32_t>(std::min<size_t>(stream_pass_limit, sorted_passes.size()));
+            for (uint32_t i = 0; i < limit; i++)
+            {
+                const auto pass = sorted_passes[i];
+                if (touches(pass, resource_kind::image, image_read_deps.begins, image_read_deps.lengthes, image_read_deps.read_list) ||
+                    touches(pass, resource_kind::image, image_write_deps.begins, image_write_deps.lengthes, image_write_deps.write_list) ||
+                    touches(pass, resource_kind::image, image_history_read_deps.begins, image_history_read_deps.lengthes, image_history_read_deps.read_list) ||
+                    touches(pass, resource_kind::buffer, buffer_read_deps.begins, buffer_read_deps.lengthes, buffer_read_deps.read_list) ||
+                    touches(pass, resource_kind::buffer, buffer_write_deps.begins, buffer_write_deps.lengthes, buffer_write_deps.write_list) ||
+                    touches(pass, resource_kind::buffer, buffer_history_read_deps.begins, buffer_history_read_deps.lengthes, buffer_history_read_deps.read_list))
+                {
+                    return i;
+                }
+            }
+            return limit;
+        }
+
+        // Step I body: barrier plan for a schedule over the current physical mapping (merged schedule or a view).
+        // With walked_passes, only that prefix of the schedule gets barriers (streaming execution); the rest of
+        // the schedule still provides the last uses the cross-frame ordering of the prefix waits for, so the
+        // prefix gets exactly the barriers of the full plan.
+        void build_barrier_plan(const std::vector<pass_handle>& schedule,
+                                per_pass_barrier& barriers,
+                                size_t walked_passes = std::numeric_limits<size_t>::max()) const
+        {
+            const auto pass_count       = graph.passes.size();
+            const auto invalid_pass     = std::numeric_limits<pass_handle>::max();
+            const auto invalid_resource = std::numeric_limits<resource_handle>::max();
+
+            barriers.clear();
+            barriers.resize_passes(pass_count);
+
+            // Scratch per-pass AoS; we will flatten into per_pass_barrier (CSR + SoA) afterwards.
+            std::vector<std::vector<barrier_op>> scratch(pass_count);
+
+            struct last_use
+            {
+                resource_handle logical   = 0;
+                uint32_t usage_bits       = 0;
+                pipeline_domain domain    = pipeline_domain::any;
+                access_type access        = access_type::read;
+                bool valid                = false;
+            };
+
+            const auto invalid_physical = invalid_resource;
+            std::vector<last_use> last_img_use(physical_resource_metas.physical_image_meta.size());
+            std::vector<last_use> last_buf_use(physical_resource_metas.physical_buffer_meta.size());
+
+            // First use of each physical id in the frame and the pass it happens in.
+            std::vector<last_use> first_img_use(physical_resource_metas.physical_image_meta.size());
+            std::vector<last_use> first_buf_use(physical_resource_metas.physical_buffer_meta.size());
+            std::vector<pass_handle> first_img_pass(physical_resource_metas.physical_image_meta.size(), invalid_pass);
+            std::vector<pass_handle> first_buf_pass(physical_resource_metas.physical_buffer_meta.size(), invalid_pass);
+
+            // Same records for the previous frame's slot of history physical ids (read_*_previous_frame).
+            std::vector<last_use> last_prev_img_use(physical_resource_metas.physical_image_meta.size());
+            std::vector<last_use> last_prev_buf_use(physical_resource_metas.physical_buffer_meta.size());
+            std::vector<last_use> first_prev_img_use(physical_resource_metas.physical_image_meta.size());
+            std::vector<last_use> first_prev_buf_use(physical_resource_metas.physical_buffer_meta.size());
+            std::vector<pass_handle> first_prev_img_pass(physical_resource_metas.physical_image_meta.size(), invalid_pass);
+            std::vector<pass_handle> first_prev_buf_pass(physical_resource_metas.physical_buffer_meta.size(), invalid_pass);
+
+            auto to_access = [](bool has_read, bool has_write) -> access_type
+            {
+                if (has_read && has_write) return access_type::read_write;
+                if (has_write) return access_type::write;
+                return access_type::read;
+            };
+
+            auto needs_uav_like = [](resource_kind kind, uint32_t usage_bits) -> bool
+            {
+                if (kind == resource_kind::image)
+                {
+                    return (usage_bits & static_cast<uint32_t>(image_usage::STORAGE)) != 0;
+                }
+                return (usage_bits & static_cast<uint32_t>(buffer_usage::STORAGE_BUFFER)) != 0;
+            };
+
+            auto insert_barrier = [&](pass_handle pass,
+                                    resource_kind kind,
+                                    resource_handle logical,
+                                    resource_handle physical,
+                                    access_type desired_access,
+                                    uint32_t desired_usage_bits,
+                                    bool previous_frame = false)
+            {
+                // validate physical id
+                if (physical == invalid_physical) return;
+
+                // get last use record (history reads track the previous frame's slot separately)
+                auto& last_vec = (kind == resource_kind::image) ? (previous_frame ? last_prev_img_use : last_img_use)
+                                                                : (previous_frame ? last_prev_buf_use : last_buf_use);
+                if (physical >= last_vec.size()) return;
+                auto& last = last_vec[physical];
+
+                if (!last.valid)
+                {
+                    auto& first_vec  = (kind == resource_kind::image) ? (previous_frame ? first_prev_img_use : first_img_use)
+                                                                      : (previous_frame ? first_prev_buf_use : first_buf_use);
+                    auto& first_pass = (kind == resource_kind::image) ? (previous_frame ? first_prev_img_pass : first_img_pass)
+                                                                      : (previous_frame ? first_prev_buf_pass : first_buf_pass);
+                    first_vec[physical] = last_use{.logical = logical, .usage_bits = desired_usage_bits, .domain = pipeline_domain::any, .access = desired_access, .valid = true};
+                    first_pass[physical] = pass;
+                }
+
+                // if this physical id was previously used by a different logical resource, insert an aliasing barrier.
+                if (last.valid && last.logical != logical)
+                {
+                    barrier_op op;
+                    op.type         = barrier_op_type::aliasing;
+                    op.kind         = kind;
+                    op.logical      = logical;
+                    op.prev_logical = last.logical;
+                    op.physical     = physical;
+                    op.previous_frame = previous_frame;
+                    scratch[pass].push_back(op);
+                }
+
+                // if state/usage changed across passes, insert a transition op.
+                // note: backends decide what 'transition' means (Vk layout+barrier, D3D12 state transition, etc.).
+                if (last.valid)
+                {
+                    const bool changed = (last.usage_bits != desired_usage_bits) || (last.access != desired_access) || (last.domain != pipeline_domain::any);
+                    if (changed)
+                    {
+                        barrier_op op;
+                        op.type          = barrier_op_type::transition;
+                        op.kind          = kind;
+                        op.logical       = logical;
+                        op.physical      = physical;
+                        op.src_domain    = last.domain;
+                        op.dst_domain    = pipeline_domain::any;
+                        op.src_access    = last.access;
+                        op.dst_access    = desired_access;
+                        op.src_usage_bits = last.usage_bits;
+                        op.dst_usage_bits = desired_usage_bits;
+                        op.previous_frame = previous_frame;
+                        scratch[pass].push_back(op);
+                    }
+
+                    // UAV-like ordering: write -> (read/write) on storage resources.
+                    if (last.access != access_type::read && needs_uav_like(kind, desired_usage_bits))
+                    {
+                        barrier_op op;
+                        op.type     = barrier_op_type::uav;
+                        op.kind     = kind;
+                        op.logical  = logical;
+                        op.physical = physical;
+                        op.previous_frame = previous_frame;
+                        scratch[pass].push_back(op);
+                    }
+                }
+                
+                // Update last use info
+                last.valid      = true;
+                last.logical    = logical;
+                last.access     = desired_access;
+                last.domain     = pipeline_domain::any;
+                last.usage_bits = desired_usage_bits;
+            };
+
+            // Resources a pass touches, reported once per logical resource with the pass's combined access.
+            auto for_each_use = [&](pass_handle pass, auto&& on_use)
+            {
+                // Images used by this pass
+                {
+                    std::unordered_map<resource_handle, std::pair<bool, bool>> rw; // logical -> {read, write}
+                    std::unordered_map<resource_handle, uint32_t> usage;
+
+                    const auto r_begin  = image_read_deps.begins[pass];
+                    const auto r_len    = image_read_deps.lengthes[pass];
+                    for (auto j = r_begin; j < r_begin + r_len; j++)
+                    {
+                        const auto logical = image_read_deps.read_list[j];
+                        rw[logical].first  = true;
+                        usage[logical] |= image_read_deps.usage_bits[j];
+                    }
+
+                    const auto w_begin = image_write_deps.begins[pass];
+                    const auto w_len   = image_write_deps.lengthes[pass];
+                    for (auto j = w_begin; j < w_begin + w_len; j++)
+                    {
+                        const auto logical  = image_write_deps.write_list[j];
+                        rw[logical].second  = true;
+                        usage[logical] |= image_write_deps.usage_bits[j];
+                    }
+
+                    for (const auto& [logical, flags] : rw)
+                    {
+                        const auto physical = (logical < physical_resource_metas.handle_to_physical_img_id.size())
+                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_img_id[logical])
+                                                  : invalid_physical;
+                        on_use(pass, resource_kind::image, logical, physical, to_access(flags.first, flags.second), usage[logical]);
+                    }
+                }
+
+                // Buffers used by this pass
+                {
+                    std::unordered_map<resource_handle, std::pair<bool, bool>> rw; // logical -> {read, write}
+                    std::unordered_map<resource_handle, uint32_t> usage;
+
+                    const auto r_begin  = buffer_read_deps.begins[pass];
+                    const auto r_len    = buffer_read_deps.lengthes[pass];
+                    for (auto j = r_begin; j < r_begin + r_len; j++)
+                    {
+                        const auto logical = buffer_read_deps.read_list[j];
+                        rw[logical].first  = true;
+                        usage[logical] |= buffer_read_deps.usage_bits[j];
+                    }
+
+                    const auto w_begin = buffer_write_deps.begins[pass];
+                    const auto w_len   = buffer_write_deps.lengthes[pass];
+                    for (auto j = w_begin; j < w_begin + w_len; j++)
+                    {
+                        const auto logical = buffer_write_deps.write_list[j];
+                        rw[logical].second = true;
+                        usage[logical] |= buffer_write_deps.usage_bits[j];
+                    }
+
+                    for (const auto& [logical, flags] : rw)
+                    {
+                        const auto physical = (logical < physical_resource_metas.handle_to_physical_buf_id.size())
+                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_buf_id[logical])
+                                                  : invalid_physical;
+                        on_use(pass, resource_kind::buffer, logical, physical, to_access(flags.first, flags.second), usage[logical]);
+                    }
+                }
+
+                // History reads (previous frame's slot of the same physical id)
+                {
+                    std::unordered_map<resource_handle, uint32_t> usage;
+                    const auto r_begin = image_history_read_deps.begins[pass];
+                    const auto r_len   = image_history_read_deps.lengthes[pass];
+                    for (auto j = r_begin; j < r_begin + r_len; j++)
+                    {
+                        usage[image_history_read_deps.read_list[j]] |= image_history_read_deps.usage_bits[j];
+                    }
+                    for (const auto& [logical, bits] : usage)
+                    {
+                        const auto physical = (logical < physical_resource_metas.handle_to_physical_img_id.size())
+                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_img_id[logical])
+                                                  : invalid_physical;
+                        on_use(pass, resource_kind::image, logical, physical, access_type::read, bits, true);
+                    }
+                }
+                {
+                    std::unordered_map<resource_handle, uint32_t> usage;
+                    const auto r_begin = buffer_history_read_deps.begins[pass];
+                    const auto r_len   = buffer_history_read_deps.lengthes[pass];
+                    for (auto j = r_begin; j < r_begin + r_len; j++)
+                    {
+                        usage[buffer_history_read_deps.read_list[j]] |= buffer_history_read_deps.usage_bits[j];
+                    }
+                    for (const auto& [logical, bits] : usage)
+                    {
+                        const auto physical = (logical < physical_resource_metas.handle_to_physical_buf_id.size())
+                                                  ? static_cast<resource_handle>(physical_resource_metas.handle_to_physical_buf_id[logical])
+                                                  : invalid_physical;
+                        on_use(pass, resource_kind::buffer, logical, physical, access_type::read, bits, true);
+                    }
+                }
+            };
+
+            // Walk scheduled passes and build barriers for all resources they touch.
+            const auto walked = std::min<size_t>(walked_passes, schedule.size());
+            for (size_t i = 0; i < walked; i++)
+            {
+                for_each_use(schedule[i], insert_barrier);
+            }
+
+            // Passes past the walked prefix only provide the wrap-around source of the cross-frame ordering: the
+            // last use of each physical id in the frame.
+            std::vector<bool> tail_img_seen(last_img_use.size(), false);
+            std::vector<bool> tail_buf_seen(last_buf_use.size(), false);
+            for (auto i = schedule.size(); i-- > walked;)
+            {
+                for_each_use(schedule[i],
+                             [&](pass_handle,
+                                 resource_kind kind,
+                                 resource_handle logical,
+                                 resource_handle physical,
+                                 access_type access,
+                                 uint32_t usage_bits,
+                                 bool previous_frame = false)
+                             {
+                                 auto& seen = (kind == resource_kind::image) ? tail_img_seen : tail_buf_seen;
+                                 if (previous_frame || physical >= seen.size() || seen[physical])
+                                 {
+                                     return;
+                                 }
+                                 seen[physical] = true;
+                                 auto& last     = (kind == resource_kind::image) ? last_img_use[physical] : last_buf_use[physical];
+                                 last = last_use{.logical = logical, .usage_bits = usage_bits, .domain = pipeline_domain::any, .access = access, .valid = true};
+                             });
+            }
+
+            // Cross-frame ordering.
+            // - Shared slots: with several frames in flight, the previous frame may still be using a shared
+            //   (non-replicated) physical id when this frame first touches it: order the first use after the last
+            //   use of the schedule (wrap-around), as if the frame loop were one long schedule.
+            // - History slots: slot(f) was last touched as the history slot of frame f - 1 (or, without history
+            //   reads, as the current slot of frame f - ring); slot(f - 1) was last touched by the previous frame's
+            //   current-slot uses. Order both first uses after those.
+            {
+                auto insert_cross_frame = [&](pass_handle pass,
+                                              resource_kind kind,
+                                              resource_handle physical,
+                                              const last_use& first,
+                                              const last_use& last,
+                                              bool previous_frame)
+                {
+                    std::vector<barrier_op> ops;
+                    if (last.logical != first.logical)
+                    {
+                        barrier_op op;
+                        op.type           = barrier_op_type::aliasing;
+                        op.kind           = kind;
+                        op.logical        = first.logical;
+                        op.prev_logical   = last.logical;
+                        op.physical       = physical;
+                        op.previous_frame = previous_frame;
+                        ops.push_back(op);
+                    }
+
+                    barrier_op op;
+                    op.type           = barrier_op_type::transition;
+                    op.kind           = kind;
+                    op.logical        = first.logical;
+                    op.physical       = physical;
+                    op.src_domain     = last.domain;
+                    op.dst_domain     = first.domain;
+                    op.src_access     = last.access;
+                    op.dst_access     = first.access;
+                    op.src_usage_bits = last.usage_bits;
+                    op.dst_usage_bits = first.usage_bits;
+                    op.previous_frame = previous_frame;
+                    ops.push_back(op);
+
+                    auto& pass_ops = scratch[pass];
+                    pass_ops.insert(pass_ops.begin(), ops.begin(), ops.end());
+                };
+
+                auto insert_cross_frames = [&](resource_kind kind,
+                                               const std::vector<last_use>& firsts,
+                                               const std::vector<last_use>& lasts,
+                                               const std::vector<pass_handle>& first_passes,
+                                               const std::vector<last_use>& prev_firsts,
+                                               const std::vector<last_use>& prev_lasts,
+                                               const std::vector<pass_handle>& prev_first_passes,
+                                               const std::vector<bool>& per_frame,
+                                               const std::vector<bool>& history,
+                                               const std::vector<resource_handle>& physical_meta,
+                                               const std::vector<bool>& is_imported)
+                {
+                    for (resource_handle physical = 0; physical < firsts.size(); physical++)
+                    {
+                        // Holes (stable aliasing) carry no resource; imported ids are synchronized externally.
+                        if (physical_meta[physical] >= is_imported.size() || is_imported[physical_meta[physical]])
+                        {
+                            continue;
+                        }
+
+                        if (history[physical])
+                        {
+                            if (prev_firsts[physical].valid && lasts[physical].valid)
+                            {
+                                insert_cross_frame(prev_first_passes[physical], kind, physical, prev_firsts[physical], lasts[physical], true);
+                            }
+                            if (firsts[physical].valid)
+                            {
+                                const auto& src = prev_lasts[physical].valid ? prev_lasts[physical] : lasts[physical];
+                                insert_cross_frame(first_passes[physical], kind, physical, firsts[physical], src, false);
+                            }
+                            continue;
+                        }
+
+                        if (frames_in_flight > 1 && firsts[physical].valid && !per_frame[physical])
+                        {
+                            insert_cross_frame(first_passes[physical], kind, physical, firsts[physical], lasts[physical], false);
+                        }
+                    }
+                };
+
+                insert_cross_frames(resource_kind::image,
+                                    first_img_use,
+                                    last_img_use,
+                                    first_img_pass,
+                                    first_prev_img_use,
+                                    last_prev_img_use,
+                                    first_prev_img_pass,
+                                    physical_resource_metas.physical_image_per_frame,
+                                    physical_resource_metas.physical_image_history,
+                                    physical_resource_metas.physical_image_meta,
+                                    meta_table.image_metas.is_imported);
+                insert_cross_frames(resource_kind::buffer,
+                                    first_buf_use,
+                                    last_buf_use,
+                                    first_buf_pass,
+                                    first_prev_buf_use,
+                                    last_prev_buf_use,
+                                    first_prev_buf_pass,
+                                    physical_resource_metas.physical_buffer_per_frame,
+                                    physical_resource_metas.physical_buffer_history,
+                                    physical_resource_metas.physical_buffer_meta,
+                                    meta_table.buffer_metas.is_imported);
+            }
+
+            // Flatten scratch into per_pass_barrier (CSR + SoA).
+            uint32_t barrier_running = 0;
+            for (pass_handle pass = 0; pass < pass_count; pass++)
+            {
+                barriers.pass_begins[pass]  = barrier_running;
+                barriers.pass_lengths[pass] = static_cast<uint32_t>(scratch[pass].size());
+                barrier_running += barriers.pass_lengths[pass];
+            }
+            barriers.pass_begins[pass_count] = barrier_running;
+
+            barriers.resize_ops(barrier_running);
+
+            for (pass_handle pass = 0; pass < pass_count; pass++)
+            {
+                const auto base = barriers.pass_begins[pass];
+                const auto len  = barriers.pass_lengths[pass];
+                for (uint32_t i = 0; i < len; i++)
+                {
+                    const auto& op = scratch[pass][i];
+                    const auto idx = base + i;
+
+                    barriers.types[idx] = op.type;
+                    barriers.kinds[idx] = op.kind;
+                    barriers.logicals[idx] = op.logical;
+                    barriers.physicals[idx] = op.physical;
+                    barriers.src_domains[idx] = op.src_domain;
+                    barriers.dst_domains[idx] = op.dst_domain;
+                    barriers.src_accesses[idx] = op.src_access;
+                    barriers.dst_accesses[idx] = op.dst_access;
+                    barriers.src_usage_bits[idx] = op.src_usage_bits;
+                    barriers.dst_usage_bits[idx] = op.dst_usage_bits;
+                    barriers.prev_logicals[idx] = op.prev_logical;
+                    barriers.previous_frames[idx] = op.previous_frame;
+                }
+            }
+        }
+
+        // Hash of everything besides the setup functions' output that shapes a compiled plan.
+        [[nodiscard]] uint64_t structural_hash() const noexcept
+        {
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            auto mix      = [&hash](uint64_t value)
+            {
+                hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+            };
+            mix(graph.passes.size());
+            mix(graph_revision);
+            mix(frames_in_flight);
+            mix(stable_aliasing ? 1 : 0);
+            mix(transitive_reduction ? 1 : 0);
+            mix(critical_path_scheduling ? 1 : 0);
+            if (critical_path_scheduling)
+            {
+                for (const auto cost : graph.costs)
+                {
+                    mix(std::bit_cast<uint32_t>(cost));
+                }
             }
+            mix((static_cast<uint64_t>(view_count) << 1) | (merge_views ? 1 : 0));
+            for (pass_handle pass = 0; pass < graph.enabled.size(); pass++)
+            {
+                mix(graph.enabled[pass] ? pass : ~static_cast<uint64_t>(pass));
+            }
+            return hash;
+        }
+
+        // Compile the graph for a variant key chosen by the user (e.g. a feature mask). If the same variant was
+        // compiled before for the same structure (same passes and enabled mask), its cached plan is swapped in
+        // without running compile(). Setup functions are not invoked on a hit, so they must declare the same
+        // graph for the same key; resource handles stay valid because the plan restores the resource registry
+        // it was compiled with. The backend is notified of the swapped-in plan like at the end of compile() (Step J).
+        void compile_variant(uint64_t variant_key)
+        {
+            uint64_t key = structural_hash();
+            key ^= variant_key + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+
+            if (auto* plan = variant_cache.find(key))
+            {
+                load_plan(*plan);
+                back_plan_dirty = true;
+                if (costs_changed())
+                {
+                    // Scheduled with older measured costs: reschedule the cached declarations and keep the entry.
+                    trace_stage compile_trace(tracer, "compile");
+                    streamed_passes = 0;
+                    compile_schedule(compile_trace);
+                    save_plan(*plan);
+                    return;
+                }
+                if (pipelined_compile)
+                {
+                    back_plan = *plan;
+                }
+                if (backend != nullptr && !pipelined_compile)
+                {
+                    backend->on_compile_resource_allocation(meta_table, physical_resource_metas);
+                    backend->on_compile_attachment_ops(per_pass_attachments);
+                }
+                return;
+            }
+
+            compile();
+            save_plan(variant_cache.insert(key));
+        }
+
+        void save_plan(compiled_plan& plan) const
+        {
+            plan.meta_table               = meta_table;
+            plan.image_read_deps          = image_read_deps;
+            plan.image_write_deps         = image_write_deps;
+            plan.buffer_read_deps         = buffer_read_deps;
+            plan.buffer_write_deps        = buffer_write_deps;
+            plan.image_history_read_deps  = image_history_read_deps;
+            plan.buffer_history_read_deps = buffer_history_read_deps;
+            plan.image_overwrite_deps     = image_overwrite_deps;
+            plan.img_ver_read_handles     = img_ver_read_handles;
+            plan.img_ver_write_handles    = img_ver_write_handles;
+            plan.buf_ver_read_handles     = buf_ver_read_handles;
+            plan.buf_ver_write_handles    = buf_ver_write_handles;
+            plan.producer_lookup_table    = producer_lookup_table;
+            plan.outputs                  = output_table;
+            plan.resource_lifetimes       = resource_lifetimes;
+            plan.physical_resource_metas  = physical_resource_metas;
+            plan.dag                      = dag;
+            plan.active_pass_flags        = active_pass_flags;
+            plan.sorted_passes            = sorted_passes;
+            plan.liveness                 = liveness;
+            plan.per_pass_barriers        = per_pass_barriers;
+            plan.per_pass_attachments     = per_pass_attachments;
+            plan.view_plans               = view_plans;
+            plan.cost_revision            = scheduled_cost_revision;
+        }
+
+        void load_plan(const compiled_plan& plan)
+        {
+            // Retained-mode records describe the previous compile, not the loaded plan.
+            mark_all_passes_dirty();
+            compiled_structure = 0;
+
+            meta_table               = plan.meta_table;
+            image_read_deps          = plan.image_read_deps;
+            image_write_deps         = plan.image_write_deps;
+            buffer_read_deps         = plan.buffer_read_deps;
+            buffer_write_deps        = plan.buffer_write_deps;
+            image_history_read_deps  = plan.image_history_read_deps;
+            buffer_history_read_deps = plan.buffer_history_read_deps;
+            image_overwrite_deps     = plan.image_overwrite_deps;
+            img_ver_read_handles     = plan.img_ver_read_handles;
+            img_ver_write_handles    = plan.img_ver_write_handles;
+            buf_ver_read_handles     = plan.buf_ver_read_handles;
+            buf_ver_write_handles    = plan.buf_ver_write_handles;
+            producer_lookup_table    = plan.producer_lookup_table;
+            output_table             = plan.outputs;
+            resource_lifetimes       = plan.resource_lifetimes;
+            physical_resource_metas  = plan.physical_resource_metas;
+            dag                      = plan.dag;
+            active_pass_flags        = plan.active_pass_flags;
+            sorted_passes            = plan.sorted_passes;
+            liveness                 = plan.liveness;
+            per_pass_barriers        = plan.per_pass_barriers;
+            per_pass_attachments     = plan.per_pass_attachments;
+            view_plans               = plan.view_plans;
+            scheduled_cost_revision  = plan.cost_revision;
         }
 
         // 3. Execution System
-        void execute()
+        // frame_params is forwarded to every execute function (pass_execute_context::params).
+        void execute(const void* frame_params = nullptr)
         {
             if (backend == nullptr)
             {
                 return;
             }
+            begin_schedule_frame();
+            const auto plan = executed_plan();
+            execute_schedule(plan.sorted_passes, plan.per_pass_barriers, frame_params);
+        }
 
-            pass_execute_context exec_ctx{.backend = backend};
+        // Same as execute(frame_params), after recording measured per-pass durations (see record_pass_durations).
+        void execute(const void* frame_params, const std::vector<float>& measured_durations)
+        {
+            if (pipelined_compile)
+            {
+                pending_durations = measured_durations;
+            }
+            else
+            {
+                record_pass_durations(measured_durations);
+            }
+            execute(frame_params);
+        }
 
-            for (const auto pass : sorted_passes)
+        // Executes a single separate view (set_views(count, false)) with its own barrier plan, in the current frame
+        // (see begin_frame).
+        void execute_view(uint32_t view, const void* frame_params = nullptr)
+        {
+            const auto plan = executed_plan();
+            assert(!merge_views && view < plan.view_plans.size() && "Error: execute_view requires separate views!");
+            if (merge_views || view >= plan.view_plans.size() || backend == nullptr)
+            {
+                return;
+            }
+            if (!frame_open || (view < frame_views.size() && frame_views[view]))
+            {
+                begin_frame();
+            }
+            frame_views.resize(plan.view_plans.size(), false);
+            frame_views[view] = true;
+            execute_schedule(plan.view_plans[view].sorted_passes, plan.view_plans[view].per_pass_barriers, frame_params);
+        }
+
+        void execute_schedule(const std::vector<pass_handle>& schedule, const per_pass_barrier& barriers, const void* frame_params)
+        {
+            if (backend == nullptr)
+            {
+                return;
+            }
+
+            RG_PROFILE_SCOPE("render_graph::execute");
+
+            const auto plan = executed_plan();
+            execute_passes(schedule, 0, schedule.size(), barriers, plan.meta_table, frame_params);
+        }
+
+        // Compiles and executes the merged schedule as one frame, streaming its first passes when
+        // set_streaming_execution() is on (see streaming execution).
+        void compile_and_execute(const void* frame_params = nullptr)
+        {
+            assert((stream_pass_limit == 0 || !pipelined_compile) && "Error: streaming execution does not apply to pipelined compiles!");
+            if (stream_pass_limit == 0 || backend == nullptr || pipelined_compile)
+            {
+                compile();
+                execute(frame_params);
+                return;
+            }
+
+            streaming_frame     = true;
+            stream_frame_params = frame_params;
+            compile();
+            streaming_frame     = false;
+            stream_frame_params = nullptr;
+
+            if (streamed_passes == 0)
+            {
+                execute(frame_params);
+                return;
+            }
+            RG_PROFILE_SCOPE("render_graph::execute");
+            execute_passes(sorted_passes, streamed_passes, sorted_passes.size(), per_pass_barriers, meta_table, frame_params);
+        }
+
+        void begin_frame()
+        {
+            frame_open = true;
+            frame_views.clear();
+            if (backend == nullptr)
+            {
+                return;
+            }
+            const auto frame = static_cast<uint32_t>(frame_counter % std::max(executed_plan().frames_in_flight, 1U));
+            backend->on_begin_frame(frame);
+            frame_counter++;
+        }
+
+        // Frame of a whole-schedule execute: the one begun by begin_frame(), or a new one if there is none or views
+        // already executed in it.
+        void begin_schedule_frame()
+        {
+            if (!frame_open || std::find(frame_views.begin(), frame_views.end(), true) != frame_views.end())
+            {
+                begin_frame();
+            }
+            frame_open = false;
+        }
+
+        // Runs schedule[begin, end) in order; metas names the resources of trace spans.
+        void execute_passes(const std::vector<pass_handle>& schedule, size_t begin, size_t end, const per_pass_barrier& barriers,
+                            const resource_meta_table& metas, const void* frame_params)
+        {
+            pass_execute_context exec_ctx{.backend = backend, .frame_params = frame_params};
+
+            for (auto i = begin; i < end; i++)
+            {
+                const auto pass          = schedule[i];
+                const auto barrier_begin = tracer != nullptr ? tracer->now_us() : 0.0;
+                {
+                    RG_PROFILE_BARRIERS(pass, pass < barriers.pass_lengths.size() ? barriers.pass_lengths[pass] : 0U);
+                    backend->apply_barriers(pass, barriers);
+                }
+                const auto execute_begin = tracer != nullptr ? tracer->now_us() : 0.0;
+                {
+                    RG_PROFILE_PASS(pass, std::string_view(graph.names[pass]));
+                    backend->on_pass_begin(pass, graph.names[pass]);
+
+                    if (pass < graph.execute_funcs.size() && graph.execute_funcs[pass])
+                    {
+                        graph.execute_funcs[pass](exec_ctx);
+                    }
+
+                    backend->on_pass_end(pass);
+                }
+
+                if (tracer != nullptr)
+                {
+                    trace_pass(pass, barriers, metas, barrier_begin, execute_begin, tracer->now_us());
+                }
+            }
+        }
+
+        // Parallel execution
+        // Runs the execute functions of the merged schedule on a job system instead of in schedule order: a pass
+        // is launched as soon as all its DAG predecessors have finished (dag.in_degrees copied into atomic
+        // counters), so independent CPU passes (visibility, simulation, streaming) run concurrently. Consecutive
+        // users of a physical id are ordered as well (build_resource_order), so aliased resources and the barrier
+        // plan's transitions see the schedule order: apply_barriers for a pass is issued after every pass its
+        // barriers depend on completed.
+        // Backend callbacks (apply_barriers, on_pass_begin/end) are serialized but may interleave between passes,
+        // so backends that record into a single command buffer should use execute() instead; backends keep
+        // per-pass state (e.g. vk_backend timestamps) keyed by pass. With a tracer set, every pass records its
+        // barrier and execute spans like in execute(), on the track of the thread that ran it
+        // (trace_recorder::thread_track). Returns when every pass has finished.
+        void execute_parallel(const void* frame_params = nullptr)
+        {
+            if (jobs == nullptr)
+            {
+                execute(frame_params);
+                return;
+            }
+            execute_parallel(*jobs, frame_params);
+        }
+
+        void execute_parallel(job_system& pool, const void* frame_params = nullptr)
+        {
+            const auto plan      = executed_plan();
+            const auto& schedule = plan.sorted_passes;
+            const auto& barriers = plan.per_pass_barriers;
+            const auto& plan_dag = plan.dag;
+            if (backend == nullptr || schedule.empty())
+            {
+                return;
+            }
+
+            RG_PROFILE_SCOPE("render_graph::execute_parallel");
+
+            begin_schedule_frame();
+
+            const auto pass_count = plan_dag.in_degrees.size();
+            const auto order      = build_resource_order(plan, pass_count);
+            std::vector<std::atomic<uint32_t>> remaining(pass_count);
+            for (size_t pass = 0; pass < pass_count; pass++)
+            {
+                remaining[pass].store(plan_dag.in_degrees[pass] + order.in_degrees[pass], std::memory_order_relaxed);
+            }
+
+            std::atomic<uint32_t> unfinished{static_cast<uint32_t>(schedule.size())};
+            std::mutex backend_mutex;
+
+            rg_function<void(pass_handle)> run_pass;
+            run_pass = [&](pass_handle pass)
+            {
+                double barrier_begin = 0.0;
+                double execute_begin = 0.0;
+                {
+                    const std::lock_guard<std::mutex> lock(backend_mutex);
+                    barrier_begin = tracer != nullptr ? tracer->now_us() : 0.0;
+                    {
+                        RG_PROFILE_BARRIERS(pass, pass < barriers.pass_lengths.size() ? barriers.pass_lengths[pass] : 0U);
+                        backend->apply_barriers(pass, barriers);
+                    }
+                    execute_begin = tracer != nullptr ? tracer->now_us() : 0.0;
+                    backend->on_pass_begin(pass, graph.names[pass]);
+                }
+                {
+                    RG_PROFILE_PASS(pass, std::string_view(graph.names[pass]));
+                    pass_execute_context exec_ctx{.backend = backend, .frame_params = frame_params};
+                    if (pass < graph.execute_funcs.size() && graph.execute_funcs[pass])
+                    {
+                        graph.execute_funcs[pass](exec_ctx);
+                    }
+                }
+                {
+                    const std::lock_guard<std::mutex> lock(backend_mutex);
+                    backend->on_pass_end(pass);
+                }
+                if (tracer != nullptr)
+                {
+                    trace_pass(pass, barriers, plan.meta_table, barrier_begin, execute_begin, tracer->now_us(), tracer->thread_track());
+                }
+
+                auto release = [&](pass_handle successor)
+                {
+                    if (remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        pool.submit([&run_pass, successor] { run_pass(successor); });
+                    }
+                };
+                for (auto i = plan_dag.adjacency_begins[pass]; i < plan_dag.adjacency_begins[pass + 1]; i++)
+                {
+                    release(plan_dag.adjacency_list[i]);
+                }
+                for (auto i = order.begins[pass]; i < order.begins[pass + 1]; i++)
+                {
+                    release(order.successors[i]);
+                }
+                unfinished.fetch_sub(1, std::memory_order_acq_rel);
+            };
+
+            for (const auto pass : schedule)
+            {
+                if (plan_dag.in_degrees[pass] == 0 && order.in_degrees[pass] == 0)
+                {
+                    pool.submit([&run_pass, pass] { run_pass(pass); });
+                }
+            }
+            pool.wait(unfinished);
+        }
+
+        // Plan read by execution: the front plan when compiles are pipelined, the compiled members otherwise.
+        struct executed_plan_refs
+        {
+            const std::vector<pass_handle>& sorted_passes;
+            const per_pass_barrier& per_pass_barriers;
+            const std::vector<view_plan>& view_plans;
+            const directed_acyclic_graph& dag;
+            const resource_meta_table& meta_table;
+            const read_dependency& image_read_deps;
+            const write_dependency& image_write_deps;
+            const read_dependency& buffer_read_deps;
+            const write_dependency& buffer_write_deps;
+            const physical_resource_meta& physical_resource_metas;
+            uint32_t frames_in_flight = 1;
+        };
+
+        [[nodiscard]] executed_plan_refs executed_plan() const
+        {
+            if (pipelined_compile)
+            {
+                return executed_plan_refs{
+                    .sorted_passes     = front_plan.sorted_passes,
+                    .per_pass_barriers = front_plan.per_pass_barriers,
+                    .view_plans        = front_plan.view_plans,
+                    .dag               = front_plan.dag,
+                    .meta_table              = front_plan.meta_table,
+                    .image_read_deps         = front_plan.image_read_deps,
+                    .image_write_deps        = front_plan.image_write_deps,
+                    .buffer_read_deps        = front_plan.buffer_read_deps,
+                    .buffer_write_deps       = front_plan.buffer_write_deps,
+                    .physical_resource_metas = front_plan.physical_resource_metas,
+                    .frames_in_flight        = front_plan.physical_resource_metas.frames_in_flight,
+                };
+            }
+            return executed_plan_refs{
+                .sorted_passes           = sorted_passes,
+                .per_pass_barriers       = per_pass_barriers,
+                .view_plans              = view_plans,
+                .dag                     = dag,
+                .meta_table              = meta_table,
+                .image_read_deps         = image_read_deps,
+                .image_write_deps        = image_write_deps,
+                .buffer_read_deps        = buffer_read_deps,
+                .buffer_write_deps       = buffer_write_deps,
+                .physical_resource_metas = physical_resource_metas,
+                .frames_in_flight        = physical_resource_metas.frames_in_flight,
+            };
+        }
+
+        // Ordering edges between consecutive users of each physical id, in schedule order (the walk of
+        // build_barrier_plan). Passes whose resources alias one physical id, or that change its state, must not
+        // overlap even where the DAG leaves them independent. Readers of the same logical resource stay unordered
+        // among themselves and the next user waits for all of them. History reads only touch the previous frame's
+        // slot and add no edges. Successor lists use the CSR layout of directed_acyclic_graph.
+        struct resource_order
+        {
+            std::vector<pass_handle> successors;
+            std::vector<uint32_t> begins;
+            std::vector<uint32_t> in_degrees;
+        };
+
+        [[nodiscard]] static resource_order build_resource_order(const executed_plan_refs& plan, size_t pass_count)
+        {
+            const auto invalid_pass = std::numeric_limits<pass_handle>::max();
+
+            // Per physical id: the logical resource of the current group, the pass that opened it (a write or the
+            // first use of an aliased logical) and the readers since.
+            struct physical_users
+            {
+                resource_handle logical = 0;
+                pass_handle head        = std::numeric_limits<pass_handle>::max();
+                std::vector<pass_handle> readers;
+                bool valid = false;
+            };
+            std::vector<physical_users> images(plan.physical_resource_metas.physical_image_meta.size());
+            std::vector<physical_users> buffers(plan.physical_resource_metas.physical_buffer_meta.size());
+            std::vector<std::pair<pass_handle, pass_handle>> edges;
+
+            auto use = [&](std::vector<physical_users>& users, pass_handle pass, resource_handle logical, uint32_t physical, bool write)
+            {
+                if (physical >= users.size())
+                {
+                    return;
+                }
+                auto& user = users[physical];
+                if (!write && !user.valid)
+                {
+                    user = physical_users{.logical = logical, .head = invalid_pass, .readers = {pass}, .valid = true};
+                    return;
+                }
+                if (!write && user.logical == logical)
+                {
+                    if (user.head != invalid_pass && user.head != pass)
+                    {
+                        edges.emplace_back(user.head, pass);
+                    }
+                    user.readers.push_back(pass);
+                    return;
+                }
+                if (user.valid && user.readers.empty() && user.head != pass)
+                {
+                    edges.emplace_back(user.head, pass);
+                }
+                for (const auto reader : user.readers)
+                {
+                    if (reader != pass)
+                    {
+                        edges.emplace_back(reader, pass);
+                    }
+                }
+                user = physical_users{.logical = logical, .head = pass, .readers = {}, .valid = true};
+            };
+
+            auto physical_of = [](const std::vector<uint32_t>& mapping, resource_handle logical)
             {
-                backend->apply_barriers(pass, per_pass_barriers);
+                return logical < mapping.size() ? mapping[logical] : std::numeric_limits<uint32_t>::max();
+            };
 
-                if (pass < graph.execute_funcs.size() && graph.execute_funcs[pass])
+            const auto& img_ids = plan.physical_resource_metas.handle_to_physical_img_id;
+            const auto& buf_ids = plan.physical_resource_metas.handle_to_physical_buf_id;
+            for (const auto pass : plan.sorted_passes)
+            {
+                const auto& ir = plan.image_read_deps;
+                for (auto j = ir.begins[pass]; j < ir.begins[pass] + ir.lengthes[pass]; j++)
+                {
+                    use(images, pass, ir.read_list[j], physical_of(img_ids, ir.read_list[j]), false);
+                }
+                const auto& iw = plan.image_write_deps;
+                for (auto j = iw.begins[pass]; j < iw.begins[pass] + iw.lengthes[pass]; j++)
+                {
+                    use(images, pass, iw.write_list[j], physical_of(img_ids, iw.write_list[j]), true);
+                }
+                const auto& br = plan.buffer_read_deps;
+                for (auto j = br.begins[pass]; j < br.begins[pass] + br.lengthes[pass]; j++)
+                {
+                    use(buffers, pass, br.read_list[j], physical_of(buf_ids, br.read_list[j]), false);
+                }
+                const auto& bw = plan.buffer_write_deps;
+                for (auto j = bw.begins[pass]; j < bw.begins[pass] + bw.lengthes[pass]; j++)
                 {
-                    graph.execute_funcs[pass](exec_ctx);
+                    use(buffers, pass, bw.write_list[j], physical_of(buf_ids, bw.write_list[j]), true);
                 }
             }
+
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            resource_order order;
+            order.begins.assign(pass_count + 1, 0);
+            order.in_degrees.assign(pass_count, 0);
+            order.successors.reserve(edges.size());
+            for (const auto& [from, to] : edges)
+            {
+                order.begins[from + 1]++;
+                order.in_degrees[to]++;
+                order.successors.push_back(to);
+            }
+            for (size_t pass = 0; pass < pass_count; pass++)
+            {
+                order.begins[pass + 1] += order.begins[pass];
+            }
+            return order;
+        }
+
+        // Barrier span args list the transitioned resources by name; resource names come from meta_table.
+        void trace_pass(pass_handle pass, const per_pass_barrier& barriers, const resource_meta_table& metas, double barrier_begin, double execute_begin,
+                        double execute_end, uint32_t track = trace_recorder::cpu_track) const
+        {
+            const auto label = graph.names[pass].empty() ? "pass " + std::to_string(pass) : graph.names[pass];
+
+            const auto count = pass < barriers.pass_lengths.size() ? barriers.pass_lengths[pass] : 0U;
+            std::string args = "\"pass\":" + std::to_string(pass) + ",\"barriers\":" + std::to_string(count) + ",\"resources\":[";
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const auto idx     = barriers.pass_begins[pass] + i;
+                const auto logical = barriers.logicals[idx];
+                const auto& names  = barriers.kinds[idx] == resource_kind::image ? metas.image_metas.names : metas.buffer_metas.names;
+                args += i == 0 ? "\"" : ",\"";
+                trace_recorder::append_escaped(args, logical < names.size() ? names[logical] : std::string{});
+                args += "\"";
+            }
+            args += "]";
+
+            tracer->span(label + " barriers", "barriers", barrier_begin, execute_begin - barrier_begin, track, std::move(args));
+            tracer->span(label, "execute", execute_begin, execute_end - execute_begin, track, "\"pass\":" + std::to_string(pass));
         }
 
         void clear()
         {
             meta_table.clear();
+            variant_cache.clear();
         }
 
         // Kahn-based cycle validation for a pass dependency DAG.
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "job_system.h"
+
+namespace render_graph
+{
+    // Built-in work-stealing job system.
+    // Every worker owns a Chase-Lev deque: jobs submitted from a worker are pushed to the bottom of its own
+    // deque and popped LIFO by the owner (cache-warm continuations) without locks; idle workers steal FIFO from
+    // the top of the others. Jobs submitted from outside the pool (or when a deque is full) go to a shared
+    // injection queue. A worker that finds nothing spins briefly, then parks until the next submit.
+    // wait() runs jobs on the calling thread until its counter drops to zero, so nested waits cannot deadlock.
+    class task_pool final : public job_system
+    {
+    public:
+        explicit task_pool(uint32_t worker_count = std::max(1U, std::thread::hardware_concurrency()), uint32_t deque_capacity = 1024)
+        {
+            worker_count = std::max(worker_count, 1U);
+            workers.reserve(worker_count);
+            for (uint32_t i = 0; i < worker_count; i++)
+            {
+                workers.push_back(std::make_unique<chase_lev_deque>(deque_capacity));
+            }
+            threads.reserve(worker_count);
+            for (uint32_t i = 0; i < worker_count; i++)
+            {
+                threads.emplace_back([this, i] { worker_main(i); });
+            }
+        }
+
+        task_pool(const task_pool&)            = delete;
+        task_pool& operator=(const task_pool&) = delete;
+
+        ~task_pool() override
+        {
+            {
+                const std::lock_guard<std::mutex> lock(park_mutex);
+                stopping.store(true);
+            }
+            park_signal.notify_all();
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            // Jobs nobody waited for are dropped.
+            for (auto& worker : workers)
+            {
+                while (auto* item = worker->pop())
+                {
+                    delete item;
+                }
+            }
+            for (auto* item : injection)
+            {
+                delete item;
+            }
+        }
+
+        [[nodiscard]] uint32_t worker_count() const override { return static_cast<uint32_t>(workers.size()); }
+
+        void submit(job work) override
+        {
+            auto* item = new job(std::move(work));
+            if (current_pool != this || !workers[current_worker]->push(item))
+            {
+                const std::lock_guard<std::mutex> lock(injection_mutex);
+                injection.push_back(item);
+            }
+
+            // A parking worker re-checks the queues after reading the epoch, so it either finds this job or
+            // sees the epoch change.
+            epoch.fetch_add(1);
+            if (parked.load() > 0)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(park_mutex);
+                }
+                park_signal.notify_one();
+            }
+        }
+
+        void wait(const std::atomic<uint32_t>& counter) override
+        {
+            const auto self = (current_pool == this) ? current_worker : no_worker;
+            while (counter.load(std::memory_order_acquire) != 0)
+            {
+                if (auto* item = find_work(self))
+                {
+                    run(item);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // Statistics (relaxed, for scaling measurements).
+        [[nodiscard]] uint64_t steal_count() const noexcept { return steals.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t park_count() const noexcept { return parks.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr uint32_t no_worker   = ~0U;
+        static constexpr uint32_t spin_rounds = 64;
+
+        // Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+        // Models"). push/pop are owner-only; steal may be called from any thread. push fails when full.
+        class chase_lev_deque
+        {
+        public:
+            explicit chase_lev_deque(uint32_t capacity_in)
+            {
+                capacity = 1;
+                while (capacity < std::max(capacity_in, 2U))
+                {
+                    capacity <<= 1;
+                }
+                slots = std::make_unique<std::atomic<job*>[]>(capacity);
+            }
+
+            bool push(job* item)
+            {
+                const auto b = bottom.load(std::memory_order_relaxed);
+                const auto t = top.load(std::memory_order_acquire);
+                if (b - t >= static_cast<int64_t>(capacity))
+                {
+                    return false;
+                }
+                slots[static_cast<size_t>(b) & (capacity - 1)].store(item, std::memory_order_release);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_release);
+                return true;
+            }
+
+            job* pop()
+            {
+                const auto b = bottom.load(std::memory_order_relaxed) - 1;
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto t = top.load(std::memory_order_relaxed);
+                if (t > b)
+                {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                auto* item = slots[static_cast<size_t>(b) & (capacity - 1)].load(std::memory_order_acquire);
+                if (t == b)
+                {
+                    // Last item: race the thieves for it.
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    {
+                        item = nullptr;
+                    }
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+                return item;
+            }
+
+            job* steal()
+            {
+                auto t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const auto b = bottom.load(std::memory_order_acquire);
+                if (t >= b)
+                {
+                    return nullptr;
+                }
+                auto* item = slots[static_cast<size_t>(t) & (capacity - 1)].load(std::memory_order_acquire);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    return nullptr; // Lost the race to another thief or the owner
+                }
+                return item;
+            }
+
+        private:
+            alignas(64) std::atomic<int64_t> top{0};
+            alignas(64) std::atomic<int64_t> bottom{0};
+            uint32_t capacity = 0;
+            std::unique_ptr<std::atomic<job*>[]> slots;
+        };
+
+        job* find_work(uint32_t self)
+        {
+            if (self != no_worker)
+            {
+                if (auto* item = workers[self]->pop())
+                {
+                    return item;
+                }
+            }
+            {
+                const std::lock_guard<std::mutex> lock(injection_mutex);
+                if (!injection.empty())
+                {
+                    auto* item = injection.front();
+                    injection.pop_front();
+                    return item;
+                }
+            }
+            const auto count = worker_count();
+            const auto first = (self != no_worker) ? self + 1 : 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const auto victim = (first + i) % count;
+                if (victim == self)
+                {
+                    continue;
+                }
+                if (auto* item = workers[victim]->steal())
+                {
+                    steals.fetch_add(1, std::memory_order_relaxed);
+                    return item;
+                }
+            }
+            return nullptr;
+        }
+
+        static void run(job* item)
+        {
+            (*item)();
+            delete item;
+        }
+
+        void worker_main(uint32_t index)
+        {
+            current_pool   = this;
+            current_worker = index;
+
+            uint32_t idle_rounds = 0;
+            for (;;)
+            {
+                if (auto* item = find_work(index))
+                {
+                    run(item);
+                    idle_rounds = 0;
+                    continue;
+                }
+                if (stopping.load())
+                {
+                    return;
+                }
+                if (++idle_rounds < spin_rounds)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // Park: re-check after reading the epoch; any later submit changes it.
+                const auto seen = epoch.load();
+                if (auto* item = find_work(index))
+                {
+                    run(item);
+                    idle_rounds = 0;
+                    continue;
+                }
+                parked.fetch_add(1);
+                parks.fetch_add(1, std::memory_order_relaxed);
+                {
+                    std::unique_lock<std::mutex> lock(park_mutex);
+                    park_signal.wait(lock, [&] { return stopping.load() || epoch.load() != seen; });
+                }
+                parked.fetch_sub(1);
+                idle_rounds = 0;
+            }
+        }
+
+        std::vector<std::unique_ptr<chase_lev_deque>> workers;
+        std::vector<std::thread> threads;
+
+        std::mutex injection_mutex;
+        std::deque<job*> injection;
+
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint32_t> parked{0};
+        std::atomic<bool> stopping{false};
+        std::mutex park_mutex;
+        std::condition_variable park_signal;
+
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> parks{0};
+
+        inline static thread_local const task_pool* current_pool = nullptr;
+        inline static thread_local uint32_t current_worker       = 0;
+    };
+} // namespace render_graph
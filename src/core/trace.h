@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "profiler.h"
+
+namespace render_graph
+{
+    // Span recorder for compile()/execute() timelines, exported as Chrome trace JSON
+    // (chrome://tracing, Perfetto). Timestamps are microseconds since the recorder was created.
+    // CPU spans go to cpu_track; GPU pass spans (e.g. vk_backend::pass_timings) go to gpu_track.
+    // Spans that overlap across threads (execute_parallel) go to one track per thread (thread_track), since
+    // trace viewers mis-nest overlapping spans of one track.
+    class trace_recorder
+    {
+    public:
+        static constexpr uint32_t cpu_track          = 1;
+        static constexpr uint32_t gpu_track          = 2;
+        static constexpr uint32_t first_thread_track = 3;
+
+        struct event
+        {
+            std::string name;
+            std::string category;
+            std::string args; // JSON object members ("key": value, ...), may be empty
+            double begin_us    = 0.0;
+            double duration_us = 0.0;
+            uint32_t track     = cpu_track;
+        };
+
+        std::vector<event> events;
+
+        [[nodiscard]] double now_us() const
+        {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+        }
+
+        void span(std::string name, std::string category, double begin_us, double duration_us, uint32_t track = cpu_track, std::string args = {})
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event{
+                .name        = std::move(name),
+                .category    = std::move(category),
+                .args        = std::move(args),
+                .begin_us    = begin_us,
+                .duration_us = duration_us,
+                .track       = track,
+            });
+        }
+
+        // Track of the calling thread, numbered from first_thread_track in order of first use.
+        [[nodiscard]] uint32_t thread_track()
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            const auto id = std::this_thread::get_id();
+            auto it       = std::find(thread_ids.begin(), thread_ids.end(), id);
+            if (it == thread_ids.end())
+            {
+                it = thread_ids.insert(thread_ids.end(), id);
+            }
+            return first_thread_track + static_cast<uint32_t>(it - thread_ids.begin());
+        }
+
+        // GPU timestamps have their own clock: callers place them relative to a CPU anchor (e.g. submit time).
+        void gpu_span(std::string name, double begin_us, double duration_us) { span(std::move(name), "gpu", begin_us, duration_us, gpu_track); }
+
+        void clear()
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            events.clear();
+        }
+
+        [[nodiscard]] std::string to_chrome_json() const
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            json += R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"CPU"}},)";
+            json += R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"GPU"}})";
+            for (uint32_t i = 0; i < thread_ids.size(); i++)
+            {
+                char name[96];
+                std::snprintf(name, sizeof(name), R"(,{"name":"thread_name","ph":"M","pid":1,"tid":%u,"args":{"name":"CPU worker %u"}})",
+                              first_thread_track + i, i);
+                json += name;
+            }
+            for (const auto& e : events)
+            {
+                char timing[96];
+                std::snprintf(timing, sizeof(timing), "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u", e.begin_us, e.duration_us, e.track);
+
+                json += ",{\"name\":\"";
+                append_escaped(json, e.name);
+                json += "\",\"cat\":\"";
+                append_escaped(json, e.category);
+                json += "\",\"ph\":\"X\",";
+                json += timing;
+                if (!e.args.empty())
+                {
+                    json += ",\"args\":{";
+                    json += e.args;
+                    json += "}";
+                }
+                json += "}";
+            }
+            json += "]}";
+            return json;
+        }
+
+        bool write_chrome_json(const std::string& path) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+            file << to_chrome_json();
+            return static_cast<bool>(file);
+        }
+
+        static void append_escaped(std::string& out, std::string_view text)
+        {
+            for (const auto c : text)
+            {
+                switch (c)
+                {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                    break;
+                }
+            }
+        }
+
+    private:
+        std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+        std::vector<std::thread::id> thread_ids; // Index + first_thread_track = track
+        mutable std::mutex mutex;
+    };
+
+    // Back-to-back spans on the CPU track (e.g. compile() steps): next() closes the current span and opens
+    // the next one, the destructor closes the last. Also drives RG_PROFILE_STAGE_BEGIN/END, so the spans
+    // reach an external profiler with or without a recorder.
+    class trace_stage
+    {
+    public:
+        trace_stage(trace_recorder* recorder_in, const char* category_in) : recorder(recorder_in), category(category_in) { }
+        trace_stage(const trace_stage&)            = delete;
+        trace_stage& operator=(const trace_stage&) = delete;
+        ~trace_stage() { end(); }
+
+        void next(const char* name)
+        {
+            end();
+            RG_PROFILE_STAGE_BEGIN(name);
+            current = name;
+            begin   = recorder != nullptr ? recorder->now_us() : 0.0;
+        }
+
+        void end()
+        {
+            if (current == nullptr)
+            {
+                return;
+            }
+            RG_PROFILE_STAGE_END(current);
+            if (recorder != nullptr)
+            {
+                recorder->span(current, category, begin, recorder->now_us() - begin);
+            }
+            current = nullptr;
+        }
+
+    private:
+        trace_recorder* recorder = nullptr;
+        const char* category     = nullptr;
+        const char* current      = nullptr;
+        double begin             = 0.0;
+    };
+} // namespace render_graph
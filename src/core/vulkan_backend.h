@@ -1,11 +1,15 @@
 #pragma once
 
 #include "backend.h"
+#include "profiler.h"
+#include "trace.h"
 #include <vulkan/vulkan.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
-#include <unordered_map>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace render_graph
@@ -20,15 +24,56 @@ namespace render_graph
         std::vector<uint32_t> logical_to_physical_img_id;
         std::vector<uint32_t> logical_to_physical_buf_id;
 
-        // Physical tables (one entry per physical id)
+        // Physical tables (one entry per slot; see physical_resource_meta frames-in-flight replication)
         std::vector<VkImage> images;
         std::vector<VkDeviceMemory> image_memories;
+        std::vector<bool> image_lazily_allocated; // True if backed by LAZILY_ALLOCATED memory
         std::vector<VkBuffer> buffers;
         std::vector<VkDeviceMemory> buffer_memories;
 
-        // Pending imported bindings (logical -> native)
-        std::unordered_map<resource_handle, VkImage> pending_imported_images;
-        std::unordered_map<resource_handle, VkBuffer> pending_imported_buffers;
+        // Description and physical id each owned slot was created for. A compile keeps the native object of a
+        // slot whose physical id and description are unchanged and only creates or retires what differs.
+        std::vector<VkImageCreateInfo> image_infos;
+        std::vector<uint32_t> image_physicals;
+        std::vector<VkBufferCreateInfo> buffer_infos;
+        std::vector<uint32_t> buffer_physicals;
+
+        // Objects a compile stopped using, destroyed by the on_begin_frame call numbered destroy_at
+        // (see backend::on_compile_resource_allocation).
+        struct retired_image
+        {
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            uint64_t destroy_at = 0;
+        };
+
+        struct retired_buffer
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            uint64_t destroy_at = 0;
+        };
+
+        uint64_t begun_frames = 0; // on_begin_frame calls so far
+        std::vector<retired_image> retired_images;
+        std::vector<retired_buffer> retired_buffers;
+
+        // Per-pass attachment load/store ops (copied from the compiled plan)
+        per_pass_attachment attachment_ops;
+
+        // Imported bindings (flat, indexed by logical handle; VK_NULL_HANDLE if unbound)
+        std::vector<VkImage> imported_images;
+        std::vector<VkBuffer> imported_buffers;
+
+        // True if the physical id is owned externally (filled at compile)
+        std::vector<bool> image_is_imported;
+        std::vector<bool> buffer_is_imported;
+
+        // Frames-in-flight slot mapping (filled at compile) and the frame being recorded.
+        uint32_t frames_in_flight = 1;
+        uint32_t current_frame = 0;
+        std::vector<uint32_t> physical_image_frame_slots;
+        std::vector<uint32_t> physical_buffer_frame_slots;
 
         void set_context(VkPhysicalDevice physical_device_in, VkDevice device_in)
         {
@@ -36,6 +81,153 @@ namespace render_graph
             device = device_in;
         }
 
+        // GPU timestamps (per-pass timing)
+        // A ring of timestamp query pools (one per frame in flight) receives a begin/end timestamp around every
+        // pass's execute function. Results are polled without waiting when the ring comes back to a slot (and by
+        // resolve_timestamps()); a slot the GPU has not finished yet is dropped instead of stalling.
+        // Nothing is created or recorded unless enable_timestamps() succeeded.
+        struct pass_timing
+        {
+            pass_handle pass = 0;
+            std::string name;
+            double begin_ms    = 0.0; // Relative to the first pass of the frame
+            double duration_ms = 0.0;
+        };
+
+        struct timestamp_frame
+        {
+            VkQueryPool pool = VK_NULL_HANDLE;
+            std::vector<pass_handle> passes; // Pass of query pair i (2i = begin, 2i+1 = end)
+            std::vector<std::string> names;
+            std::vector<uint32_t> pass_queries; // Query pair of each pass handle (~0U: none), see on_pass_end
+            bool pending = false;
+        };
+
+        bool timestamps_enabled = false;
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE; // Command buffer passes record into (set before execute())
+        double timestamp_period_ns = 1.0;
+        uint32_t max_timestamp_passes = 0;
+        uint32_t timestamp_frame_index = 0;
+        uint64_t dropped_timestamp_frames = 0;
+        std::vector<timestamp_frame> timestamp_frames;
+
+        // Latest resolved frame: timings in execution order, and durations indexed by pass handle
+        // (-1 for passes without a sample; see render_graph_system::record_pass_durations).
+        std::vector<pass_timing> pass_timings;
+        std::vector<float> pass_durations_ms;
+
+        // Adds the latest resolved frame to a trace as GPU spans. GPU and CPU clocks are not correlated:
+        // anchor_us (recorder time, e.g. taken at submit) places the first pass.
+        void trace_pass_timings(trace_recorder& recorder, double anchor_us) const
+        {
+            for (const auto& timing : pass_timings)
+            {
+                recorder.gpu_span(timing.name.empty() ? "pass " + std::to_string(timing.pass) : timing.name, anchor_us + (timing.begin_ms * 1000.0),
+                                  timing.duration_ms * 1000.0);
+            }
+        }
+
+        void set_command_buffer(VkCommandBuffer command_buffer_in)
+        {
+            command_buffer = command_buffer_in;
+        }
+
+        bool enable_timestamps(uint32_t ring_size, uint32_t max_passes)
+        {
+            disable_timestamps();
+            if (!physical_device || !device || ring_size == 0 || max_passes == 0)
+            {
+                return false;
+            }
+
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(physical_device, &properties);
+            if (properties.limits.timestampComputeAndGraphics != VK_TRUE || properties.limits.timestampPeriod <= 0.0F)
+            {
+                return false;
+            }
+            timestamp_period_ns = properties.limits.timestampPeriod;
+            max_timestamp_passes = max_passes;
+
+            timestamp_frames.resize(ring_size);
+            for (auto& frame : timestamp_frames)
+            {
+                VkQueryPoolCreateInfo ci{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+                ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+                ci.queryCount = max_passes * 2;
+                if (vkCreateQueryPool(device, &ci, nullptr, &frame.pool) != VK_SUCCESS)
+                {
+                    disable_timestamps();
+                    return false;
+                }
+            }
+            timestamps_enabled = true;
+            return true;
+        }
+
+        void disable_timestamps()
+        {
+            for (auto& frame : timestamp_frames)
+            {
+                if (frame.pool != VK_NULL_HANDLE)
+                {
+                    vkDestroyQueryPool(device, frame.pool, nullptr);
+                }
+            }
+            timestamp_frames.clear();
+            timestamps_enabled = false;
+        }
+
+        // Polls every pending slot without waiting; the newest completed frame becomes pass_timings.
+        // Call after the command buffer of the current frame has been submitted (its reset must precede the poll).
+        void resolve_timestamps()
+        {
+            for (uint32_t i = 1; i <= timestamp_frames.size(); i++)
+            {
+                // Oldest slot first, so the newest completed frame wins.
+                resolve_timestamp_frame(timestamp_frames[(timestamp_frame_index + i) % timestamp_frames.size()]);
+            }
+        }
+
+        void on_pass_begin(pass_handle pass, std::string_view name) override
+        {
+            if (!timestamps_enabled || command_buffer == VK_NULL_HANDLE)
+            {
+                return;
+            }
+            auto& frame = timestamp_frames[timestamp_frame_index];
+            const auto query = static_cast<uint32_t>(frame.passes.size());
+            if (query >= max_timestamp_passes)
+            {
+                return;
+            }
+            if (pass >= frame.pass_queries.size())
+            {
+                frame.pass_queries.resize(static_cast<size_t>(pass) + 1, ~0U);
+            }
+            frame.pass_queries[pass] = query;
+            frame.passes.push_back(pass);
+            frame.names.emplace_back(name);
+            frame.pending = true;
+            vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.pool, query * 2);
+        }
+
+        void on_pass_end(pass_handle pass) override
+        {
+            if (!timestamps_enabled || command_buffer == VK_NULL_HANDLE)
+            {
+                return;
+            }
+            // Keyed by pass: execute_parallel() interleaves the begin/end calls of concurrent passes.
+            auto& frame = timestamp_frames[timestamp_frame_index];
+            if (pass >= frame.pass_queries.size() || frame.pass_queries[pass] == ~0U)
+            {
+                return;
+            }
+            const auto query = frame.pass_queries[pass];
+            vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.pool, (query * 2) + 1);
+        }
+
         void apply_barriers(pass_handle /*pass*/, const per_pass_barrier& /*plan*/) override
         {
             // TODO: Lower barrier_op into VkImageMemoryBarrier2/VkBufferMemoryBarrier2 etc.
@@ -68,6 +260,25 @@ namespace render_graph
             return flags;
         }
 
+        static VkAttachmentLoadOp to_vk_load_op(attachment_load_op op)
+        {
+            switch (op)
+            {
+            case attachment_load_op::clear:     return VK_ATTACHMENT_LOAD_OP_CLEAR;
+            case attachment_load_op::dont_care: return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            default: return VK_ATTACHMENT_LOAD_OP_LOAD;
+            }
+        }
+
+        static VkAttachmentStoreOp to_vk_store_op(attachment_store_op op)
+        {
+            switch (op)
+            {
+            case attachment_store_op::dont_care: return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            default: return VK_ATTACHMENT_STORE_OP_STORE;
+            }
+        }
+
         static VkBufferUsageFlags to_vk_usage(buffer_usage usage)
         {
             VkBufferUsageFlags flags = 0;
@@ -101,53 +312,85 @@ namespace render_graph
             return std::numeric_limits<uint32_t>::max();
         }
 
+        // Cheap enough to call every frame (e.g. after acquiring the next swapchain image):
+        // once compiled, the physical slot of the imported handle is patched in place.
         void bind_imported_image(resource_handle logical_image,
                                  native_handle native_image,
                                  native_handle /*native_view*/ = 0) override
         {
             // NOLINTNEXTLINE(performance-no-int-to-ptr)
-            pending_imported_images[logical_image] = reinterpret_cast<VkImage>(native_image);
+            const auto image = reinterpret_cast<VkImage>(native_image);
+            if (logical_image >= imported_images.size())
+            {
+                imported_images.resize(static_cast<size_t>(logical_image) + 1, VK_NULL_HANDLE);
+            }
+            imported_images[logical_image] = image;
+
+            const auto physical_id = get_physical_image_id(logical_image);
+            if (physical_id < images.size() && image_is_imported[physical_id])
+            {
+                images[physical_id] = image;
+            }
         }
 
         void bind_imported_buffer(resource_handle logical_buffer,
                                   native_handle native_buffer) override
         {
             // NOLINTNEXTLINE(performance-no-int-to-ptr)
-            pending_imported_buffers[logical_buffer] = reinterpret_cast<VkBuffer>(native_buffer);
+            const auto buffer = reinterpret_cast<VkBuffer>(native_buffer);
+            if (logical_buffer >= imported_buffers.size())
+            {
+                imported_buffers.resize(static_cast<size_t>(logical_buffer) + 1, VK_NULL_HANDLE);
+            }
+            imported_buffers[logical_buffer] = buffer;
+
+            const auto physical_id = get_physical_buffer_id(logical_buffer);
+            if (physical_id < buffers.size() && buffer_is_imported[physical_id])
+            {
+                buffers[physical_id] = buffer;
+            }
         }
 
         void on_compile_resource_allocation(const resource_meta_table& meta,
                                             const physical_resource_meta& physical_meta) override
         {
+            RG_PROFILE_SCOPE("vk_backend::allocate");
+
+            const auto previous_frames_in_flight = frames_in_flight;
             logical_to_physical_img_id = physical_meta.handle_to_physical_img_id;
             logical_to_physical_buf_id = physical_meta.handle_to_physical_buf_id;
+            frames_in_flight = physical_meta.frames_in_flight;
+            physical_image_frame_slots = physical_meta.physical_image_frame_slots;
+            physical_buffer_frame_slots = physical_meta.physical_buffer_frame_slots;
 
-            images.assign(physical_meta.physical_image_meta.size(), VK_NULL_HANDLE);
-            image_memories.assign(physical_meta.physical_image_meta.size(), VK_NULL_HANDLE);
-            buffers.assign(physical_meta.physical_buffer_meta.size(), VK_NULL_HANDLE);
-            buffer_memories.assign(physical_meta.physical_buffer_meta.size(), VK_NULL_HANDLE);
+            // One native object per slot; replicas of per-frame physical ids follow the physical ids.
+            const auto image_slot_count = std::max(physical_meta.image_slot_to_physical.size(), physical_meta.physical_image_meta.size());
+            const auto buffer_slot_count = std::max(physical_meta.buffer_slot_to_physical.size(), physical_meta.physical_buffer_meta.size());
 
-            if (!physical_device || !device)
+            // Imported slots only reference external objects; fill them even without a device.
+            // Imported physical ids are never replicated, so their slot is the physical id.
+            image_is_imported.assign(image_slot_count, false);
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
             {
-                return;
+                const auto rep = physical_meta.physical_image_meta[physical_id];
+                image_is_imported[physical_id] = rep < meta.image_metas.names.size() && meta.image_metas.is_imported[rep];
+            }
+            buffer_is_imported.assign(buffer_slot_count, false);
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            {
+                const auto rep = physical_meta.physical_buffer_meta[physical_id];
+                buffer_is_imported[physical_id] = rep < meta.buffer_metas.names.size() && meta.buffer_metas.is_imported[rep];
             }
 
-            // Images
-            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
+            // Describe every slot the backend owns (sType stays 0 for imported and empty slots).
+            std::vector<VkImageCreateInfo> next_image_infos(image_slot_count, VkImageCreateInfo{});
+            std::vector<uint32_t> next_image_physicals(image_slot_count, std::numeric_limits<uint32_t>::max());
+            for (size_t slot = 0; slot < image_slot_count; slot++)
             {
+                const auto physical_id = (slot < physical_meta.image_slot_to_physical.size()) ? physical_meta.image_slot_to_physical[slot] : slot;
                 const auto rep = physical_meta.physical_image_meta[physical_id];
-                if (rep >= meta.image_metas.names.size())
-                {
-                    continue;
-                }
-
-                if (meta.image_metas.is_imported[rep])
+                if (rep >= meta.image_metas.names.size() || image_is_imported[slot])
                 {
-                    auto it = pending_imported_images.find(rep);
-                    if (it != pending_imported_images.end())
-                    {
-                        images[physical_id] = it->second;
-                    }
                     continue;
                 }
 
@@ -164,6 +407,114 @@ namespace render_graph
                 ci.samples = static_cast<VkSampleCountFlagBits>(meta.image_metas.sample_counts[rep]);
                 ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+                // Attachment-only images never leave the render passes: mark them transient so
+                // tile-based GPUs can keep them on-chip.
+                if (physical_id < physical_meta.physical_image_memoryless.size() && physical_meta.physical_image_memoryless[physical_id])
+                {
+                    ci.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+                }
+
+                next_image_infos[slot] = ci;
+                next_image_physicals[slot] = static_cast<uint32_t>(physical_id);
+            }
+
+            std::vector<VkBufferCreateInfo> next_buffer_infos(buffer_slot_count, VkBufferCreateInfo{});
+            std::vector<uint32_t> next_buffer_physicals(buffer_slot_count, std::numeric_limits<uint32_t>::max());
+            for (size_t slot = 0; slot < buffer_slot_count; slot++)
+            {
+                const auto physical_id = (slot < physical_meta.buffer_slot_to_physical.size()) ? physical_meta.buffer_slot_to_physical[slot] : slot;
+                const auto rep = physical_meta.physical_buffer_meta[physical_id];
+                if (rep >= meta.buffer_metas.names.size() || buffer_is_imported[slot])
+                {
+                    continue;
+                }
+
+                VkBufferCreateInfo ci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+                ci.size = meta.buffer_metas.sizes[rep];
+                ci.usage = to_vk_usage(meta.buffer_metas.usages[rep]);
+                ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+                next_buffer_infos[slot] = ci;
+                next_buffer_physicals[slot] = static_cast<uint32_t>(physical_id);
+            }
+
+            // Keep the native objects of slots whose physical id and description did not change (recompiles of
+            // the same graph, variant and plan swaps). Every other object is retired: frames recorded with the
+            // previous plan may still use it (see retire_image).
+            const auto retire_frames = std::max(previous_frames_in_flight, frames_in_flight);
+            {
+                std::vector<VkImage> next_images(image_slot_count, VK_NULL_HANDLE);
+                std::vector<VkDeviceMemory> next_memories(image_slot_count, VK_NULL_HANDLE);
+                std::vector<bool> next_lazily_allocated(image_slot_count, false);
+                for (size_t slot = 0; slot < image_memories.size(); slot++)
+                {
+                    if (slot < image_slot_count && image_memories[slot] != VK_NULL_HANDLE && next_image_physicals[slot] == image_physicals[slot] &&
+                        same_image_desc(next_image_infos[slot], image_infos[slot]))
+                    {
+                        next_images[slot] = images[slot];
+                        next_memories[slot] = image_memories[slot];
+                        next_lazily_allocated[slot] = image_lazily_allocated[slot];
+                        continue;
+                    }
+                    retire_image(images[slot], image_memories[slot], retire_frames);
+                }
+                images = std::move(next_images);
+                image_memories = std::move(next_memories);
+                image_lazily_allocated = std::move(next_lazily_allocated);
+            }
+            {
+                std::vector<VkBuffer> next_buffers(buffer_slot_count, VK_NULL_HANDLE);
+                std::vector<VkDeviceMemory> next_memories(buffer_slot_count, VK_NULL_HANDLE);
+                for (size_t slot = 0; slot < buffer_memories.size(); slot++)
+                {
+                    if (slot < buffer_slot_count && buffer_memories[slot] != VK_NULL_HANDLE && next_buffer_physicals[slot] == buffer_physicals[slot] &&
+                        same_buffer_desc(next_buffer_infos[slot], buffer_infos[slot]))
+                    {
+                        next_buffers[slot] = buffers[slot];
+                        next_memories[slot] = buffer_memories[slot];
+                        continue;
+                    }
+                    retire_buffer(buffers[slot], buffer_memories[slot], retire_frames);
+                }
+                buffers = std::move(next_buffers);
+                buffer_memories = std::move(next_memories);
+            }
+            image_infos = std::move(next_image_infos);
+            image_physicals = std::move(next_image_physicals);
+            buffer_infos = std::move(next_buffer_infos);
+            buffer_physicals = std::move(next_buffer_physicals);
+
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_image_meta.size(); physical_id++)
+            {
+                if (image_is_imported[physical_id])
+                {
+                    const auto rep = physical_meta.physical_image_meta[physical_id];
+                    images[physical_id] = (rep < imported_images.size()) ? imported_images[rep] : VK_NULL_HANDLE;
+                }
+            }
+            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            {
+                if (buffer_is_imported[physical_id])
+                {
+                    const auto rep = physical_meta.physical_buffer_meta[physical_id];
+                    buffers[physical_id] = (rep < imported_buffers.size()) ? imported_buffers[rep] : VK_NULL_HANDLE;
+                }
+            }
+
+            if (!physical_device || !device)
+            {
+                return;
+            }
+
+            // Images
+            for (size_t slot = 0; slot < image_slot_count; slot++)
+            {
+                const auto& ci = image_infos[slot];
+                if (ci.sType != VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO || image_memories[slot] != VK_NULL_HANDLE)
+                {
+                    continue;
+                }
+
                 VkImage image = VK_NULL_HANDLE;
                 if (vkCreateImage(device, &ci, nullptr, &image) != VK_SUCCESS)
                 {
@@ -172,7 +523,20 @@ namespace render_graph
 
                 VkMemoryRequirements req{};
                 vkGetImageMemoryRequirements(device, image, &req);
-                const auto mem_type = find_memory_type(physical_device, req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+                // Prefer lazily-allocated memory for transient attachments; fall back to plain device-local
+                // memory when the device exposes no such memory type (e.g. most desktop GPUs).
+                auto mem_type = std::numeric_limits<uint32_t>::max();
+                if ((ci.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0)
+                {
+                    mem_type = find_memory_type(physical_device, req.memoryTypeBits,
+                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+                }
+                const bool lazily_allocated = (mem_type != std::numeric_limits<uint32_t>::max());
+                if (mem_type == std::numeric_limits<uint32_t>::max())
+                {
+                    mem_type = find_memory_type(physical_device, req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                }
                 if (mem_type == std::numeric_limits<uint32_t>::max())
                 {
                     vkDestroyImage(device, image, nullptr);
@@ -191,34 +555,22 @@ namespace render_graph
                 }
                 (void)vkBindImageMemory(device, image, memory, 0);
 
-                images[physical_id] = image;
-                image_memories[physical_id] = memory;
+                RG_PROFILE_ALLOCATION(resource_kind::image, slot, req.size);
+
+                images[slot] = image;
+                image_memories[slot] = memory;
+                image_lazily_allocated[slot] = lazily_allocated;
             }
 
             // Buffers
-            for (size_t physical_id = 0; physical_id < physical_meta.physical_buffer_meta.size(); physical_id++)
+            for (size_t slot = 0; slot < buffer_slot_count; slot++)
             {
-                const auto rep = physical_meta.physical_buffer_meta[physical_id];
-                if (rep >= meta.buffer_metas.names.size())
+                const auto& ci = buffer_infos[slot];
+                if (ci.sType != VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO || buffer_memories[slot] != VK_NULL_HANDLE)
                 {
                     continue;
                 }
 
-                if (meta.buffer_metas.is_imported[rep])
-                {
-                    auto it = pending_imported_buffers.find(rep);
-                    if (it != pending_imported_buffers.end())
-                    {
-                        buffers[physical_id] = it->second;
-                    }
-                    continue;
-                }
-
-                VkBufferCreateInfo ci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-                ci.size = meta.buffer_metas.sizes[rep];
-                ci.usage = to_vk_usage(meta.buffer_metas.usages[rep]);
-                ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
                 VkBuffer buffer = VK_NULL_HANDLE;
                 if (vkCreateBuffer(device, &ci, nullptr, &buffer) != VK_SUCCESS)
                 {
@@ -246,9 +598,289 @@ namespace render_graph
                 }
                 (void)vkBindBufferMemory(device, buffer, memory, 0);
 
-                buffers[physical_id] = buffer;
-                buffer_memories[physical_id] = memory;
+                RG_PROFILE_ALLOCATION(resource_kind::buffer, slot, req.size);
+
+                buffers[slot] = buffer;
+                buffer_memories[slot] = memory;
+            }
+        }
+
+        // Destroys every native object the backend owns (e.g. before destroying the device).
+        void release_resources()
+        {
+            for (size_t slot = 0; slot < images.size(); slot++)
+            {
+                destroy_image(images[slot], image_memories[slot]);
+                images[slot] = VK_NULL_HANDLE;
+                image_memories[slot] = VK_NULL_HANDLE;
+            }
+            for (size_t slot = 0; slot < buffers.size(); slot++)
+            {
+                destroy_buffer(buffers[slot], buffer_memories[slot]);
+                buffers[slot] = VK_NULL_HANDLE;
+                buffer_memories[slot] = VK_NULL_HANDLE;
+            }
+            image_infos.clear();
+            image_physicals.clear();
+            buffer_infos.clear();
+            buffer_physicals.clear();
+            for (const auto& retired : retired_images)
+            {
+                destroy_image(retired.image, retired.memory);
+            }
+            for (const auto& retired : retired_buffers)
+            {
+                destroy_buffer(retired.buffer, retired.memory);
+            }
+            retired_images.clear();
+            retired_buffers.clear();
+        }
+
+        // Destruction is deferred until the frames that may use the object are known to be complete: the caller
+        // waits for a frame's fence before its on_begin_frame, so after frames on_begin_frame calls every frame
+        // recorded before the retirement has finished on the GPU.
+        void retire_image(VkImage image, VkDeviceMemory memory, uint32_t frames)
+        {
+            if (memory != VK_NULL_HANDLE)
+            {
+                retired_images.push_back(retired_image{image, memory, begun_frames + frames});
+            }
+        }
+
+        void retire_buffer(VkBuffer buffer, VkDeviceMemory memory, uint32_t frames)
+        {
+            if (memory != VK_NULL_HANDLE)
+            {
+                retired_buffers.push_back(retired_buffer{buffer, memory, begun_frames + frames});
+            }
+        }
+
+        void destroy_retired_resources()
+        {
+            std::erase_if(retired_images, [&](const retired_image& retired)
+                          {
+                              if (retired.destroy_at > begun_frames)
+                              {
+                                  return false;
+                              }
+                              destroy_image(retired.image, retired.memory);
+                              return true;
+                          });
+            std::erase_if(retired_buffers, [&](const retired_buffer& retired)
+                          {
+                              if (retired.destroy_at > begun_frames)
+                              {
+                                  return false;
+                              }
+                              destroy_buffer(retired.buffer, retired.memory);
+                              return true;
+                          });
+        }
+
+        // Owned slots hold their memory; imported slots only reference an external object.
+        void destroy_image(VkImage image, VkDeviceMemory memory) const
+        {
+            if (memory != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(device, image, nullptr);
+                vkFreeMemory(device, memory, nullptr);
+            }
+        }
+
+        void destroy_buffer(VkBuffer buffer, VkDeviceMemory memory) const
+        {
+            if (memory != VK_NULL_HANDLE)
+            {
+                vkDestroyBuffer(device, buffer, nullptr);
+                vkFreeMemory(device, memory, nullptr);
+            }
+        }
+
+        [[nodiscard]] static bool same_image_desc(const VkImageCreateInfo& a, const VkImageCreateInfo& b)
+        {
+            return a.sType == b.sType && a.extent.width == b.extent.width && a.extent.height == b.extent.height &&
+                   a.extent.depth == b.extent.depth && a.mipLevels == b.mipLevels && a.arrayLayers == b.arrayLayers &&
+                   a.format == b.format && a.usage == b.usage && a.samples == b.samples;
+        }
+
+        [[nodiscard]] static bool same_buffer_desc(const VkBufferCreateInfo& a, const VkBufferCreateInfo& b)
+        {
+            return a.sType == b.sType && a.size == b.size && a.usage == b.usage;
+        }
+
+        void on_compile_attachment_ops(const per_pass_attachment& plan) override
+        {
+            attachment_ops = plan;
+        }
+
+        // Attachment description of a pass, ready to be lowered into VkAttachmentDescription
+        // or VkRenderingAttachmentInfo by the pass's execute lambda.
+        struct attachment_info
+        {
+            resource_handle logical = 0;
+            VkImage image = VK_NULL_HANDLE;
+            VkAttachmentLoadOp load_op = VK_ATTACHMENT_LOAD_OP_LOAD;
+            VkAttachmentStoreOp store_op = VK_ATTACHMENT_STORE_OP_STORE;
+            bool is_depth_stencil = false;
+        };
+
+        void get_pass_attachments(pass_handle pass, std::vector<attachment_info>& out) const
+        {
+            out.clear();
+            if (pass >= attachment_ops.pass_lengths.size())
+            {
+                return;
+            }
+
+            const auto begin = attachment_ops.pass_begins[pass];
+            const auto end = begin + attachment_ops.pass_lengths[pass];
+            for (auto i = begin; i < end; i++)
+            {
+                const auto slot = resolve_image_slot(attachment_ops.physicals[i]);
+                attachment_info info;
+                info.logical = attachment_ops.logicals[i];
+                info.image = (slot < images.size()) ? images[slot] : VK_NULL_HANDLE;
+                info.load_op = to_vk_load_op(attachment_ops.load_ops[i]);
+                info.store_op = to_vk_store_op(attachment_ops.store_ops[i]);
+                info.is_depth_stencil = (attachment_ops.usage_bits[i] & static_cast<uint32_t>(image_usage::DEPTH_STENCIL_ATTACHMENT)) != 0;
+                out.push_back(info);
+            }
+        }
+
+        void on_begin_frame(uint32_t frame_in_flight) override
+        {
+            current_frame = frame_in_flight;
+            begun_frames++;
+            destroy_retired_resources();
+
+            if (timestamps_enabled && command_buffer != VK_NULL_HANDLE)
+            {
+                // Advance the ring; the slot being reused held the frame ring_size frames ago.
+                timestamp_frame_index = (timestamp_frame_index + 1) % static_cast<uint32_t>(timestamp_frames.size());
+                auto& frame = timestamp_frames[timestamp_frame_index];
+                resolve_timestamp_frame(frame);
+                if (frame.pending)
+                {
+                    dropped_timestamp_frames++;
+                }
+                frame.passes.clear();
+                frame.names.clear();
+                frame.pass_queries.clear();
+                frame.pending = false;
+                vkCmdResetQueryPool(command_buffer, frame.pool, 0, max_timestamp_passes * 2);
+            }
+        }
+
+        void resolve_timestamp_frame(timestamp_frame& frame)
+        {
+            if (!frame.pending || frame.passes.empty())
+            {
+                return;
+            }
+
+            // (value, availability) pairs; VK_NOT_READY leaves the slot pending.
+            const auto query_count = static_cast<uint32_t>(frame.passes.size() * 2);
+            std::vector<uint64_t> results(static_cast<size_t>(query_count) * 2, 0);
+            const auto result = vkGetQueryPoolResults(device, frame.pool, 0, query_count, results.size() * sizeof(uint64_t), results.data(),
+                                                      sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+            if (result != VK_SUCCESS)
+            {
+                return;
+            }
+            for (uint32_t query = 0; query < query_count; query++)
+            {
+                if (results[(static_cast<size_t>(query) * 2) + 1] == 0)
+                {
+                    return;
+                }
+            }
+
+            pass_timings.clear();
+            const auto frame_begin = results[0];
+            for (size_t i = 0; i < frame.passes.size(); i++)
+            {
+                const auto begin = results[i * 4];
+                const auto end = results[(i * 4) + 2];
+                const auto ticks = (end > begin) ? (end - begin) : 0;
+                const auto offset = (begin > frame_begin) ? (begin - frame_begin) : 0;
+                pass_timings.push_back(pass_timing{frame.passes[i], frame.names[i], static_cast<double>(offset) * timestamp_period_ns * 1e-6,
+                                                   static_cast<double>(ticks) * timestamp_period_ns * 1e-6});
+            }
+            for (auto& duration : pass_durations_ms)
+            {
+                duration = -1.0F;
+            }
+            for (const auto& timing : pass_timings)
+            {
+                if (timing.pass >= pass_durations_ms.size())
+                {
+                    pass_durations_ms.resize(static_cast<size_t>(timing.pass) + 1, -1.0F);
+                }
+                pass_durations_ms[timing.pass] = static_cast<float>(timing.duration_ms);
+            }
+            frame.pending = false;
+        }
+
+        // Resolve a physical id (as used by the compiled plan) to the slot of the frame being recorded,
+        // or to the slot holding the previous frame's contents of a history resource (barrier_op::previous_frame).
+        [[nodiscard]] uint32_t resolve_image_slot(uint32_t physical, bool previous_frame = false) const
+        {
+            const auto frame = previous_frame ? (current_frame + frames_in_flight - 1) % frames_in_flight : current_frame;
+            const auto idx   = (static_cast<size_t>(physical) * frames_in_flight) + frame;
+            return (idx < physical_image_frame_slots.size()) ? physical_image_frame_slots[idx] : physical;
+        }
+
+        [[nodiscard]] uint32_t resolve_buffer_slot(uint32_t physical, bool previous_frame = false) const
+        {
+            const auto frame = previous_frame ? (current_frame + frames_in_flight - 1) % frames_in_flight : current_frame;
+            const auto idx   = (static_cast<size_t>(physical) * frames_in_flight) + frame;
+            return (idx < physical_buffer_frame_slots.size()) ? physical_buffer_frame_slots[idx] : physical;
+        }
+
+        // Native objects of a logical resource for the frame being recorded.
+        [[nodiscard]] VkImage get_image(resource_handle logical) const
+        {
+            const auto physical = get_physical_image_id(logical);
+            if (physical == std::numeric_limits<uint32_t>::max())
+            {
+                return VK_NULL_HANDLE;
+            }
+            const auto slot = resolve_image_slot(physical);
+            return (slot < images.size()) ? images[slot] : VK_NULL_HANDLE;
+        }
+
+        // Previous frame's contents of a history resource (read_image_previous_frame).
+        [[nodiscard]] VkImage get_history_image(resource_handle logical) const
+        {
+            const auto physical = get_physical_image_id(logical);
+            if (physical == std::numeric_limits<uint32_t>::max())
+            {
+                return VK_NULL_HANDLE;
+            }
+            const auto slot = resolve_image_slot(physical, true);
+            return (slot < images.size()) ? images[slot] : VK_NULL_HANDLE;
+        }
+
+        [[nodiscard]] VkBuffer get_buffer(resource_handle logical) const
+        {
+            const auto physical = get_physical_buffer_id(logical);
+            if (physical == std::numeric_limits<uint32_t>::max())
+            {
+                return VK_NULL_HANDLE;
+            }
+            const auto slot = resolve_buffer_slot(physical);
+            return (slot < buffers.size()) ? buffers[slot] : VK_NULL_HANDLE;
+        }
+
+        [[nodiscard]] VkBuffer get_history_buffer(resource_handle logical) const
+        {
+            const auto physical = get_physical_buffer_id(logical);
+            if (physical == std::numeric_limits<uint32_t>::max())
+            {
+                return VK_NULL_HANDLE;
             }
+            const auto slot = resolve_buffer_slot(physical, true);
+            return (slot < buffers.size()) ? buffers[slot] : VK_NULL_HANDLE;
         }
 
         [[nodiscard]] uint32_t get_physical_image_id(resource_handle logical) const
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "render_graph/system.h"
+#include "render_graph/trace.h"
 #include "render_graph/vulkan_backend.h"
 
 #include <vulkan/vulkan.h>
@@ -435,6 +436,57 @@ int main()
     //   same shape/format/usage if lifetimes do not overlap (greedy first-fit).
     // - Buffers b0 (passes 0-1) and b1 (passes 2-3) have disjoint lifetimes and may alias.
 
+    // Per-pass GPU timestamps: record one frame into a command buffer, submit it and read the durations back.
+    if ((vk.device != nullptr) && (vk.graphics_queue != nullptr) && backend.enable_timestamps(2, 16))
+    {
+        VkCommandPoolCreateInfo pool_ci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        pool_ci.queueFamilyIndex = vk.graphics_queue_family;
+        VkCommandPool pool = VK_NULL_HANDLE;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        if (vkCreateCommandPool(vk.device, &pool_ci, nullptr, &pool) == VK_SUCCESS)
+        {
+            VkCommandBufferAllocateInfo alloc{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            alloc.commandPool = pool;
+            alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            alloc.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(vk.device, &alloc, &cmd) == VK_SUCCESS)
+            {
+                VkCommandBufferBeginInfo begin{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+                begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                (void)vkBeginCommandBuffer(cmd, &begin);
+                // Trace the recorded frame (CPU spans) and, once resolved, its GPU passes next to it.
+                render_graph::trace_recorder recorder;
+                system.set_tracer(&recorder);
+                backend.set_command_buffer(cmd);
+                system.execute();
+                (void)vkEndCommandBuffer(cmd);
+                const auto submit_us = recorder.now_us();
+
+                VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+                submit.commandBufferCount = 1;
+                submit.pCommandBuffers = &cmd;
+                (void)vkQueueSubmit(vk.graphics_queue, 1, &submit, VK_NULL_HANDLE);
+                (void)vkQueueWaitIdle(vk.graphics_queue);
+
+                backend.resolve_timestamps();
+                std::cout << "  pass timings (GPU):\n";
+                for (const auto& timing : backend.pass_timings)
+                {
+                    std::cout << "    pass " << timing.pass << " " << timing.name << ": " << timing.duration_ms << " ms\n";
+                }
+                backend.trace_pass_timings(recorder, submit_us);
+                system.set_tracer(nullptr);
+                if (recorder.write_chrome_json("render_graph_trace.json"))
+                {
+                    std::cout << "  trace written to render_graph_trace.json\n";
+                }
+                backend.set_command_buffer(VK_NULL_HANDLE);
+            }
+            vkDestroyCommandPool(vk.device, pool, nullptr);
+        }
+        backend.disable_timestamps();
+    }
+
     if (vk.device != nullptr)
     {
         for (size_t i = 0; i < backend.images.size(); i++)
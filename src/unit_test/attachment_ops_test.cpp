@@ -0,0 +1,195 @@
+#include "render_graph/unit_test/attachment_ops_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle albedo  = 0;
+            resource_handle depth   = 0;
+            resource_handle hdr     = 0;
+            resource_handle aux     = 0;
+            resource_handle stats   = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: gbuffer writes albedo + depth (first versions -> CLEAR).
+        void gbuffer_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.albedo = ctx.create_image(color_info("albedo", image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED));
+            s.depth = ctx.create_image(image_info{
+                .name          = "depth",
+                .fmt           = format::D32_SFLOAT,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::DEPTH_STENCIL_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            ctx.write_image(s.albedo, image_usage::COLOR_ATTACHMENT);
+            ctx.write_image(s.depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+        }
+
+        // Pass 1: forward lighting depth-tests against gbuffer depth (its last use) and writes HDR.
+        void forward_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.albedo, image_usage::SAMPLED);
+            ctx.read_image(s.depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+
+            s.hdr = ctx.create_image(color_info("hdr", image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED));
+            ctx.write_image(s.hdr, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: overlay blends onto HDR (read + write -> LOAD).
+        void overlay_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.hdr, image_usage::COLOR_ATTACHMENT);
+            ctx.write_image(s.hdr, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: composite writes the first version of final + an auxiliary buffer.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.hdr, image_usage::SAMPLED);
+
+            s.final_c = ctx.create_image(color_info("final", image_usage::COLOR_ATTACHMENT));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+
+            s.aux = ctx.create_buffer(buffer_info{
+                .name     = "aux",
+                .size     = 256,
+                .usage    = buffer_usage::STORAGE_BUFFER,
+                .imported = false,
+            });
+            ctx.write_buffer(s.aux, buffer_usage::STORAGE_BUFFER);
+        }
+
+        // Pass 4: HUD drawn over part of final without reading it (earlier version in the plan -> LOAD).
+        void hud_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_buffer(s.aux, buffer_usage::STORAGE_BUFFER);
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+
+            s.stats = ctx.create_buffer(buffer_info{
+                .name     = "stats",
+                .size     = 256,
+                .usage    = buffer_usage::STORAGE_BUFFER,
+                .imported = false,
+            });
+            ctx.write_buffer(s.stats, buffer_usage::STORAGE_BUFFER);
+        }
+
+        // Pass 5: declared full overwrite of final (-> DONT_CARE), declares it as output.
+        void overwrite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_buffer(s.stats, buffer_usage::STORAGE_BUFFER);
+            ctx.overwrite_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        struct attachment_ops
+        {
+            bool found                = false;
+            attachment_load_op load   = attachment_load_op::load;
+            attachment_store_op store = attachment_store_op::store;
+        };
+
+        attachment_ops find_ops(const per_pass_attachment& plan, pass_handle pass, resource_handle logical)
+        {
+            const auto begin = plan.pass_begins[pass];
+            const auto end   = begin + plan.pass_lengths[pass];
+            for (auto i = begin; i < end; i++)
+            {
+                if (plan.logicals[i] == logical)
+                {
+                    return attachment_ops{.found = true, .load = plan.load_ops[i], .store = plan.store_ops[i]};
+                }
+            }
+            return attachment_ops{};
+        }
+    } // namespace
+
+    void attachment_ops_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.add_pass(gbuffer_setup, noop_execute);   // 0
+        system.add_pass(forward_setup, noop_execute);   // 1
+        system.add_pass(overlay_setup, noop_execute);   // 2
+        system.add_pass(composite_setup, noop_execute); // 3
+        system.add_pass(hud_setup, noop_execute);       // 4
+        system.add_pass(overwrite_setup, noop_execute); // 5
+
+        system.compile();
+
+        const auto& plan = system.per_pass_attachments;
+        assert(plan.pass_begins.size() == 7);
+        assert(plan.pass_lengths.size() == 6);
+
+        // Pass 0: first writes, both consumed later.
+        auto ops = find_ops(plan, 0, s.albedo);
+        assert(ops.found && ops.load == attachment_load_op::clear && ops.store == attachment_store_op::store);
+        ops = find_ops(plan, 0, s.depth);
+        assert(ops.found && ops.load == attachment_load_op::clear && ops.store == attachment_store_op::store);
+
+        // Pass 1: sampled albedo is not an attachment; depth is loaded and dropped after its last use.
+        assert(plan.pass_lengths[1] == 2);
+        assert(!find_ops(plan, 1, s.albedo).found);
+        ops = find_ops(plan, 1, s.depth);
+        assert(ops.found && ops.load == attachment_load_op::load && ops.store == attachment_store_op::dont_care);
+        ops = find_ops(plan, 1, s.hdr);
+        assert(ops.found && ops.load == attachment_load_op::clear && ops.store == attachment_store_op::store);
+
+        // Pass 2: read-modify-write keeps previous contents.
+        ops = find_ops(plan, 2, s.hdr);
+        assert(ops.found && ops.load == attachment_load_op::load && ops.store == attachment_store_op::store);
+
+        // Pass 3: first write.
+        ops = find_ops(plan, 3, s.final_c);
+        assert(ops.found && ops.load == attachment_load_op::clear && ops.store == attachment_store_op::store);
+
+        // Pass 4: a plain write may be partial, so the earlier contents are loaded.
+        ops = find_ops(plan, 4, s.final_c);
+        assert(ops.found && ops.load == attachment_load_op::load && ops.store == attachment_store_op::store);
+
+        // Pass 5: declared full overwrite without reading it; declared output must be stored.
+        ops = find_ops(plan, 5, s.final_c);
+        assert(ops.found && ops.load == attachment_load_op::dont_care && ops.store == attachment_store_op::store);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Builds gbuffer -> forward -> overlay -> composite -> hud -> overwrite passes and validates the per-pass
+    // attachment load/store ops derived from earlier writes, declared overwrites and lifetimes.
+    void attachment_ops_test();
+}
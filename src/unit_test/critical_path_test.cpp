@@ -0,0 +1,115 @@
+#include "render_graph/unit_test/critical_path_test.h"
+
+#include <cassert>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle ui      = 0;
+            resource_handle shadow  = 0;
+            resource_handle light   = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: cheap ui.
+        void ui_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.ui = ctx.create_image(color_info("ui"));
+            ctx.write_image(s.ui, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: expensive shadow map.
+        void shadow_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.shadow = ctx.create_image(color_info("shadow"));
+            ctx.write_image(s.shadow, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: expensive lighting, depends on the shadow map.
+        void lighting_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.shadow, image_usage::SAMPLED);
+            s.light = ctx.create_image(color_info("light"));
+            ctx.write_image(s.light, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: composite of ui and lighting.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.ui, image_usage::SAMPLED);
+            ctx.read_image(s.light, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+    } // namespace
+
+    void critical_path_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        const auto ui        = system.add_pass(ui_setup, noop_execute);        // 0
+        const auto shadow    = system.add_pass(shadow_setup, noop_execute);    // 1
+        const auto lighting  = system.add_pass(lighting_setup, noop_execute);  // 2
+        const auto composite = system.add_pass(composite_setup, noop_execute); // 3
+
+        // Default costs: FIFO order, critical path counts passes.
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{0, 1, 2, 3}));
+        assert(system.critical_path_length == 3.0F);
+
+        system.set_pass_cost(shadow, 5.0F);
+        system.set_pass_cost(lighting, 5.0F);
+        system.set_pass_cost(ui, 1.0F);
+        system.set_pass_cost(composite, 1.0F);
+
+        // Costs alone do not change the FIFO schedule.
+        s.reset();
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{0, 1, 2, 3}));
+        assert(system.critical_path_length == 11.0F);
+
+        // Critical path first: shadow -> lighting before the cheap ui pass.
+        system.set_critical_path_scheduling(true);
+        s.reset();
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{1, 2, 0, 3}));
+        assert(system.critical_path_length == 11.0F);
+
+        // Making ui the most expensive chain moves it first.
+        system.set_pass_cost(ui, 20.0F);
+        s.reset();
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{0, 1, 2, 3}));
+        assert(system.critical_path_length == 21.0F);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Critical-path scheduling: ready passes are ordered by bottom level; critical path length follows pass costs.
+    void critical_path_test();
+}
@@ -0,0 +1,148 @@
+#include "render_graph/unit_test/frames_in_flight_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle scratch = 0;
+            resource_handle hdr     = 0;
+            resource_handle ldr     = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: compute writes a transient scratch buffer.
+        void compute_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.scratch = ctx.create_buffer(buffer_info{
+                .name     = "scratch",
+                .size     = 4096,
+                .usage    = buffer_usage::STORAGE_BUFFER,
+                .imported = false,
+            });
+            ctx.write_buffer(s.scratch, buffer_usage::STORAGE_BUFFER);
+        }
+
+        // Pass 1: lighting reads the scratch buffer and writes a transient HDR image.
+        void lighting_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_buffer(s.scratch, buffer_usage::STORAGE_BUFFER);
+
+            s.hdr = ctx.create_image(color_info("hdr", image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED));
+            ctx.write_image(s.hdr, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: tonemap samples HDR and writes the declared output.
+        void tonemap_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.hdr, image_usage::SAMPLED);
+
+            s.ldr = ctx.create_image(color_info("ldr", image_usage::COLOR_ATTACHMENT));
+            ctx.write_image(s.ldr, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.ldr);
+        }
+
+        void build(render_graph_system& system, uint32_t frames_in_flight)
+        {
+            test_state().reset();
+
+            system.set_frames_in_flight(frames_in_flight);
+            system.add_pass(compute_setup, noop_execute);  // 0
+            system.add_pass(lighting_setup, noop_execute); // 1
+            system.add_pass(tonemap_setup, noop_execute);  // 2
+            system.compile();
+        }
+
+        bool has_transition(const per_pass_barrier& plan, pass_handle pass, resource_kind kind, resource_handle logical)
+        {
+            const auto begin = plan.pass_begins[pass];
+            const auto end   = begin + plan.pass_lengths[pass];
+            for (auto i = begin; i < end; i++)
+            {
+                if (plan.types[i] == barrier_op_type::transition && plan.kinds[i] == kind && plan.logicals[i] == logical)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    void frames_in_flight_test()
+    {
+        auto& s = test_state();
+
+        // Single frame in flight: every physical id is its own slot, no cross-frame ordering.
+        {
+            render_graph_system system;
+            build(system, 1);
+
+            const auto& metas = system.physical_resource_metas;
+            assert(metas.frames_in_flight == 1);
+            assert(metas.image_slot_to_physical.size() == metas.physical_image_meta.size());
+            assert(metas.buffer_slot_to_physical.size() == metas.physical_buffer_meta.size());
+            assert(!has_transition(system.per_pass_barriers, 0, resource_kind::buffer, s.scratch));
+            (void)system;
+        }
+
+        // Three frames in flight.
+        render_graph_system system;
+        build(system, 3);
+
+        const auto& metas = system.physical_resource_metas;
+        assert(metas.frames_in_flight == 3);
+        assert(metas.physical_image_frame_slots.size() == metas.physical_image_meta.size() * 3);
+        assert(metas.physical_buffer_frame_slots.size() == metas.physical_buffer_meta.size() * 3);
+
+        // The declared output gets one distinct slot per frame; frame 0 is the physical id itself.
+        const auto ldr_physical = metas.handle_to_physical_img_id[s.ldr];
+        assert(metas.physical_image_per_frame[ldr_physical]);
+        const auto ldr_0 = metas.resolve_image_slot(ldr_physical, 0);
+        const auto ldr_1 = metas.resolve_image_slot(ldr_physical, 1);
+        const auto ldr_2 = metas.resolve_image_slot(ldr_physical, 2);
+        assert(ldr_0 == ldr_physical);
+        assert(ldr_1 != ldr_0 && ldr_2 != ldr_0 && ldr_1 != ldr_2);
+        assert(metas.image_slot_to_physical[ldr_1] == ldr_physical);
+        assert(metas.image_slot_to_physical[ldr_2] == ldr_physical);
+        assert(metas.image_slot_to_physical.size() == metas.physical_image_meta.size() + 2);
+        assert(metas.resolve_image_slot(ldr_physical, 3) == ldr_0);
+
+        // Transients share a single slot across frames.
+        const auto hdr_physical = metas.handle_to_physical_img_id[s.hdr];
+        assert(!metas.physical_image_per_frame[hdr_physical]);
+        for (uint32_t frame = 0; frame < 3; frame++)
+        {
+            assert(metas.resolve_image_slot(hdr_physical, frame) == hdr_physical);
+        }
+        const auto scratch_physical = metas.handle_to_physical_buf_id[s.scratch];
+        assert(!metas.physical_buffer_per_frame[scratch_physical]);
+        assert(metas.buffer_slot_to_physical.size() == metas.physical_buffer_meta.size());
+
+        // Shared slots are ordered after the previous frame's last use at their first use.
+        assert(has_transition(system.per_pass_barriers, 0, resource_kind::buffer, s.scratch));
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
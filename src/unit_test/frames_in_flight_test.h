@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies frames-in-flight replication: declared outputs get one slot per frame,
+    // transient physical ids stay shared and are ordered across frames by a wrap-around transition.
+    void frames_in_flight_test();
+}
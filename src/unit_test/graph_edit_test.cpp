@@ -0,0 +1,252 @@
+#include "render_graph/unit_test/graph_edit_test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle color   = 0;
+            resource_handle final_c = 0;
+            resource_handle debug   = 0;
+            resource_handle hud     = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene color.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: post writes the final image.
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        // Pass 2: debug view of the scene color (its own output).
+        void debug_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.debug = ctx.create_image(color_info("debug_view"));
+            ctx.write_image(s.debug, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.debug);
+        }
+
+        // Replacement for pass 2: a wireframe view instead.
+        void wireframe_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.debug = ctx.create_image(color_info("wireframe_view"));
+            ctx.write_image(s.debug, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.debug);
+        }
+
+        // Pass 3: HUD (independent output).
+        void hud_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.hud = ctx.create_image(color_info("hud"));
+            ctx.write_image(s.hud, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.hud);
+        }
+
+        // Independent overlay outputs, so that edits stay under the replay threshold.
+        template <int N>
+        void overlay_setup(pass_setup_context& ctx)
+        {
+            constexpr const char* names[] = {"overlay0", "overlay1", "overlay2", "overlay3"};
+            const auto overlay            = ctx.create_image(color_info(names[N]));
+            ctx.write_image(overlay, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(overlay);
+        }
+
+        bool is_scheduled(const render_graph_system& system, pass_handle pass)
+        {
+            return std::find(system.sorted_passes.begin(), system.sorted_passes.end(), pass) != system.sorted_passes.end();
+        }
+
+        std::vector<std::vector<std::pair<pass_handle, uint8_t>>> dag_edges(const render_graph_system& system)
+        {
+            const auto& dag = system.dag;
+            std::vector<std::vector<std::pair<pass_handle, uint8_t>>> edges(dag.adjacency_begins.size() - 1);
+            for (size_t from = 0; from < edges.size(); from++)
+            {
+                for (auto j = dag.adjacency_begins[from]; j < dag.adjacency_begins[from + 1]; j++)
+                {
+                    edges[from].emplace_back(dag.adjacency_list[j], dag.edge_kinds[j]);
+                }
+                std::sort(edges[from].begin(), edges[from].end());
+            }
+            return edges;
+        }
+
+        // The edited compile must order the DAG topologically and derive what a compile from scratch derives.
+        void check_matches_full_compile(render_graph_system& system)
+        {
+            assert(system.last_compile_incremental);
+
+            std::vector<size_t> positions(system.graph.passes.size(), system.sorted_passes.size());
+            for (size_t i = 0; i < system.sorted_passes.size(); i++)
+            {
+                positions[system.sorted_passes[i]] = i;
+            }
+            const auto edges = dag_edges(system);
+            for (pass_handle from = 0; from < edges.size(); from++)
+            {
+                for (const auto& edge : edges[from])
+                {
+                    assert(positions[from] < positions[edge.first]);
+                }
+            }
+
+            const auto active_pass_flags     = system.active_pass_flags;
+            const auto producer_lookup_table = system.producer_lookup_table;
+            const auto img_ver_read_handles  = system.img_ver_read_handles;
+            const auto img_ver_write_handles = system.img_ver_write_handles;
+
+            system.compile(); // no pending edits: every setup runs again
+            assert(!system.last_compile_replayed_setup && !system.last_compile_incremental);
+            assert(active_pass_flags == system.active_pass_flags);
+            assert(edges == dag_edges(system));
+            assert(producer_lookup_table.img_version_offsets == system.producer_lookup_table.img_version_offsets);
+            assert(producer_lookup_table.img_version_producers == system.producer_lookup_table.img_version_producers);
+            assert(producer_lookup_table.latest_img == system.producer_lookup_table.latest_img);
+            assert(img_ver_read_handles == system.img_ver_read_handles);
+            assert(img_ver_write_handles == system.img_ver_write_handles);
+            (void)positions;
+        }
+    } // namespace
+
+    void graph_edit_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        const auto scene = system.add_pass(scene_setup, noop_execute);
+        const auto post  = system.add_pass(post_setup, noop_execute);
+        const auto debug = system.add_pass(debug_setup, noop_execute);
+        const auto hud   = system.add_pass(hud_setup, noop_execute);
+
+        system.compile();
+        assert(!system.last_compile_replayed_setup);
+        assert(system.last_setup_invocations == 4);
+        assert(system.sorted_passes.size() == 4);
+
+        // Disabling one pass: setup is replayed, no setup runs at all.
+        const auto debug_image = s.debug;
+        system.set_pass_enabled(debug, false);
+        system.compile();
+        assert(system.last_compile_replayed_setup);
+        assert(system.last_setup_invocations == 0);
+        assert(!is_scheduled(system, debug));
+        assert(is_scheduled(system, scene) && is_scheduled(system, post) && is_scheduled(system, hud));
+        assert(!system.meta_table.image_registry.is_alive(debug_image));
+        check_matches_full_compile(system);
+
+        // Re-enabling only re-runs that pass.
+        system.set_pass_enabled(debug, true);
+        system.compile();
+        assert(system.last_compile_replayed_setup);
+        assert(system.last_setup_invocations == 1);
+        assert(is_scheduled(system, debug));
+        check_matches_full_compile(system);
+
+        // Replacing a pass swaps its declarations.
+        system.replace_pass(debug, wireframe_setup, noop_execute);
+        system.compile();
+        assert(system.last_compile_replayed_setup);
+        assert(system.last_setup_invocations == 1);
+        assert(system.meta_table.image_metas.names[s.debug] == "wireframe_view");
+        assert(system.image_read_deps.lengthes[debug] == 0);
+        check_matches_full_compile(system);
+
+        // Removing a pass leaves a tombstone; its handle is never reused.
+        system.remove_pass(hud);
+        system.compile();
+        assert(system.last_setup_invocations == 0);
+        assert(!is_scheduled(system, hud));
+        check_matches_full_compile(system);
+        const auto again = system.add_pass(hud_setup, noop_execute);
+        assert(again == 4);
+        system.compile();
+        assert(system.last_setup_invocations == 1);
+        assert(is_scheduled(system, again));
+        check_matches_full_compile(system);
+        system.set_pass_enabled(hud, true); // no effect on a removed pass
+        assert(!system.graph.enabled[hud]);
+
+        // Editing more than the threshold invokes every setup again.
+        system.set_pass_enabled(debug, false);
+        system.set_pass_enabled(again, false);
+        system.compile();
+        assert(!system.last_compile_replayed_setup && !system.last_compile_incremental);
+        assert(system.last_setup_invocations == 2); // scene + post; disabled/removed passes declare nothing
+        assert(system.sorted_passes.size() == 2);
+
+        // Culling follows edits: without its readers the scene pass is culled, and comes back with them.
+        s.reset();
+        render_graph_system culled;
+        const auto culled_scene = culled.add_pass(scene_setup, noop_execute);
+        const auto culled_post  = culled.add_pass(post_setup, noop_execute);
+        const auto culled_debug = culled.add_pass(debug_setup, noop_execute);
+        culled.add_pass(hud_setup, noop_execute);
+        culled.add_pass(overlay_setup<0>, noop_execute);
+        culled.add_pass(overlay_setup<1>, noop_execute);
+        culled.add_pass(overlay_setup<2>, noop_execute);
+        culled.add_pass(overlay_setup<3>, noop_execute);
+        culled.compile();
+        assert(culled.sorted_passes.size() == 8);
+
+        culled.set_pass_enabled(culled_post, false);
+        culled.set_pass_enabled(culled_debug, false);
+        culled.compile();
+        assert(culled.last_compile_incremental);
+        assert(!culled.active_pass_flags[culled_scene]);
+        assert(culled.sorted_passes.size() == 5);
+        check_matches_full_compile(culled);
+
+        culled.set_pass_enabled(culled_post, true);
+        culled.set_pass_enabled(culled_debug, true);
+        culled.compile();
+        assert(culled.last_compile_incremental);
+        assert(culled.active_pass_flags[culled_scene]);
+        assert(culled.sorted_passes.size() == 8);
+        check_matches_full_compile(culled);
+
+        (void)system;
+        (void)culled_scene;
+    }
+} // namespace render_graph::unit_test
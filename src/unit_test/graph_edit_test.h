@@ -0,0 +1,9 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies remove_pass/replace_pass/set_pass_enabled: edits re-run only the edited passes' setup,
+    // removed handles are never reused, small edits update versions, culling, DAG and order to what a compile
+    // from scratch derives, and large edits fall back to a full compile.
+    void graph_edit_test();
+}
@@ -0,0 +1,183 @@
+#include "render_graph/unit_test/hazard_edges_test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle scratch = 0;
+            resource_handle blur    = 0;
+            resource_handle params  = 0;
+            resource_handle final_c = 0;
+            resource_handle target  = 0;
+            resource_handle copy    = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: writes scratch (v0) and reads an imported parameter buffer nobody has written yet.
+        void prepare_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.params = ctx.create_buffer(buffer_info{
+                .name     = "params",
+                .size     = 256,
+                .usage    = buffer_usage::STORAGE_BUFFER,
+                .imported = true,
+            });
+            ctx.read_buffer(s.params, buffer_usage::STORAGE_BUFFER);
+
+            s.scratch = ctx.create_image(color_info("scratch"));
+            ctx.write_image(s.scratch, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: blur reads scratch v0.
+        void blur_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.scratch, image_usage::SAMPLED);
+            s.blur = ctx.create_image(color_info("blur"));
+            ctx.write_image(s.blur, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: overwrites scratch (v1) without reading it: must wait for the blur (WAR) and pass 0 (WAW).
+        void overwrite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.write_image(s.scratch, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: composites scratch v1 with the blur, updates the parameter buffer.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.scratch, image_usage::SAMPLED);
+            ctx.read_image(s.blur, image_usage::SAMPLED);
+            ctx.write_buffer(s.params, buffer_usage::STORAGE_BUFFER);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+            ctx.declare_buffer_output(s.params);
+        }
+
+        // Culled writer between two live writers: 0 writes target, 1 reads it, 2 overwrites it for nobody,
+        // 3 writes the declared output version.
+        void target_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.target = ctx.create_image(color_info("target"));
+            ctx.write_image(s.target, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void copy_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.target, image_usage::SAMPLED);
+            s.copy = ctx.create_image(color_info("copy"));
+            ctx.write_image(s.copy, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.copy);
+        }
+
+        void dead_write_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.write_image(s.target, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void final_write_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.write_image(s.target, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.target);
+        }
+
+        uint8_t edge_kinds(const directed_acyclic_graph& dag, pass_handle from, pass_handle to)
+        {
+            for (auto i = dag.adjacency_begins[from]; i < dag.adjacency_begins[from + 1]; i++)
+            {
+                if (dag.adjacency_list[i] == to)
+                {
+                    return dag.edge_kinds[i];
+                }
+            }
+            return 0;
+        }
+
+        constexpr auto raw = static_cast<uint8_t>(dependency_kind::read_after_write);
+        constexpr auto war = static_cast<uint8_t>(dependency_kind::write_after_read);
+        constexpr auto waw = static_cast<uint8_t>(dependency_kind::write_after_write);
+    } // namespace
+
+    void hazard_edges_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.add_pass(prepare_setup, noop_execute);   // 0
+        system.add_pass(blur_setup, noop_execute);      // 1
+        system.add_pass(overwrite_setup, noop_execute); // 2
+        system.add_pass(composite_setup, noop_execute); // 3
+
+        system.compile();
+
+        const auto& dag = system.dag;
+        assert(dag.edge_kinds.size() == dag.adjacency_list.size());
+
+        assert(edge_kinds(dag, 0, 1) == raw);
+        assert(edge_kinds(dag, 1, 2) == war);
+        assert(edge_kinds(dag, 0, 2) == waw);
+        assert(edge_kinds(dag, 2, 3) == raw);
+        assert(edge_kinds(dag, 1, 3) == raw);
+        // The imported buffer is read before its first write.
+        assert(edge_kinds(dag, 0, 3) == war);
+        assert(dag.adjacency_list.size() == 6);
+
+        // Without the WAR edge, pass 2 would have no predecessor and could run before the blur.
+        assert(dag.in_degrees[2] == 2);
+        assert((system.sorted_passes == std::vector<pass_handle>{0, 1, 2, 3}));
+
+        // WAR/WAW edges skip the culled writer and reach the next live one.
+        render_graph_system culled;
+        culled.add_pass(target_setup, noop_execute);      // 0
+        culled.add_pass(copy_setup, noop_execute);        // 1
+        culled.add_pass(dead_write_setup, noop_execute);  // 2
+        culled.add_pass(final_write_setup, noop_execute); // 3
+
+        culled.compile();
+
+        assert((culled.active_pass_flags == std::vector<bool>{true, true, false, true}));
+        assert(edge_kinds(culled.dag, 0, 1) == raw);
+        assert(edge_kinds(culled.dag, 1, 3) == war);
+        assert(edge_kinds(culled.dag, 0, 3) == waw);
+        assert(culled.dag.adjacency_list.size() == 3);
+        assert((culled.sorted_passes == std::vector<pass_handle>{0, 1, 3}));
+
+        (void)system;
+        (void)culled;
+    }
+} // namespace render_graph::unit_test
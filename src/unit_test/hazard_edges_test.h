@@ -0,0 +1,7 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Hazard edges: WAR/WAW edges order readers and writers before the next live writer; edge kinds are merged.
+    void hazard_edges_test();
+}
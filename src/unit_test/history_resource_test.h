@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies previous-frame (history) reads: ping-pong slots, aliasing before the first write,
+    // and cross-frame barriers on both the current and the previous frame's slot.
+    void history_resource_test();
+}
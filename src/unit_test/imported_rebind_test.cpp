@@ -0,0 +1,128 @@
+#include "render_graph/unit_test/imported_rebind_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/vulkan_backend.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle color      = 0;
+            resource_handle backbuffer = 0;
+            uint32_t setups            = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene into a transient color target.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.setups++;
+
+            s.color = ctx.create_image(image_info{
+                .name          = "color",
+                .fmt           = format::R8G8B8A8_UNORM,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: present into the imported swapchain image.
+        void present_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.setups++;
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.backbuffer = ctx.create_image(image_info{
+                .name          = "backbuffer",
+                .fmt           = format::B8G8R8A8_UNORM,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::COLOR_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = true,
+            });
+            ctx.write_image(s.backbuffer, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.backbuffer);
+        }
+
+        // Stand-in for a swapchain image: never dereferenced without a device.
+        backend::native_handle fake_image(uint32_t index) { return static_cast<backend::native_handle>(0x1000U * (index + 1)); }
+
+        VkImage as_vk_image(backend::native_handle handle)
+        {
+            // NOLINTNEXTLINE(performance-no-int-to-ptr)
+            return reinterpret_cast<VkImage>(handle);
+        }
+
+        bool same_barriers(const per_pass_barrier& a, const per_pass_barrier& b)
+        {
+            return a.pass_begins == b.pass_begins && a.pass_lengths == b.pass_lengths && a.logicals == b.logicals &&
+                   a.physicals == b.physicals && a.dst_usage_bits == b.dst_usage_bits;
+        }
+    } // namespace
+
+    void imported_rebind_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        vk_backend backend_impl; // No device: only imported slots are filled
+        render_graph_system system;
+        system.set_backend(&backend_impl);
+        system.add_pass(scene_setup, noop_execute);   // 0
+        system.add_pass(present_setup, noop_execute); // 1
+
+        system.compile();
+        assert(s.setups == 2);
+        assert(backend_impl.get_image(s.backbuffer) == VK_NULL_HANDLE);
+        assert(backend_impl.get_image(s.color) == VK_NULL_HANDLE);
+
+        const auto sorted_passes     = system.sorted_passes;
+        const auto per_pass_barriers = system.per_pass_barriers;
+
+        // Swapchain rotation: rebinding patches the imported slot in place.
+        for (uint32_t frame = 0; frame < 6; frame++)
+        {
+            const auto image = fake_image(frame % 3);
+            backend_impl.bind_imported_image(s.backbuffer, image);
+            assert(backend_impl.get_image(s.backbuffer) == as_vk_image(image));
+            assert(backend_impl.get_image(s.color) == VK_NULL_HANDLE);
+        }
+        assert(s.setups == 2);
+        assert(system.sorted_passes == sorted_passes);
+        assert(same_barriers(system.per_pass_barriers, per_pass_barriers));
+
+        // The last binding survives a recompile.
+        system.compile();
+        assert(s.setups == 4);
+        assert(backend_impl.get_image(s.backbuffer) == as_vk_image(fake_image(2)));
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Compiles a graph presenting into an imported image once, rebinds the image on a device-less vk_backend
+    // every frame and checks that the resolved handle follows the binding without recompiling or touching the plan.
+    void imported_rebind_test();
+}
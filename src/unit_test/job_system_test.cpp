@@ -0,0 +1,176 @@
+#include "render_graph/unit_test/job_system_test.h"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+#include "render_graph/job_system.h"
+#include "render_graph/system.h"
+#include "render_graph/task_pool.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        // Engine-side job system stand-in: runs every job inline and counts them.
+        struct inline_jobs final : job_system
+        {
+            uint32_t submits = 0;
+
+            [[nodiscard]] uint32_t worker_count() const override { return 1; }
+
+            void submit(job work) override
+            {
+                submits++;
+                work();
+            }
+        };
+
+        struct null_backend final : backend
+        {
+            std::atomic<uint32_t> applied{0};
+
+            void apply_barriers(pass_handle, const per_pass_barrier&) override { applied.fetch_add(1); }
+        };
+
+        void noop_execute(pass_execute_context&) { }
+
+        struct graph_handles
+        {
+            resource_handle scene  = 0;
+            resource_handle main_c = 0;
+            resource_handle mirror = 0;
+        };
+
+        // Two views sharing a scene pass; setup state lives in h so systems can compile concurrently.
+        void build_graph(render_graph_system& system, graph_handles& h)
+        {
+            constexpr view_mask main_view   = 1U << 0;
+            constexpr view_mask mirror_view = 1U << 1;
+
+            system.add_pass(
+                [&h](pass_setup_context& ctx)
+                {
+                    h.scene = ctx.create_image(color_info("scene"));
+                    ctx.write_image(h.scene, image_usage::COLOR_ATTACHMENT);
+                },
+                noop_execute);
+            system.add_pass(
+                [&h](pass_setup_context& ctx)
+                {
+                    ctx.read_image(h.scene, image_usage::SAMPLED);
+                    h.main_c = ctx.create_image(color_info("main"));
+                    ctx.write_image(h.main_c, image_usage::COLOR_ATTACHMENT);
+                    ctx.declare_image_output(h.main_c, main_view);
+                },
+                noop_execute);
+            system.add_pass(
+                [&h](pass_setup_context& ctx)
+                {
+                    ctx.read_image(h.scene, image_usage::SAMPLED);
+                    h.mirror = ctx.create_image(color_info("mirror"));
+                    ctx.write_image(h.mirror, image_usage::COLOR_ATTACHMENT);
+                    ctx.declare_image_output(h.mirror, mirror_view);
+                },
+                noop_execute);
+            system.set_views(2, false);
+        }
+
+        bool same_barriers(const per_pass_barrier& a, const per_pass_barrier& b)
+        {
+            return a.pass_begins == b.pass_begins && a.pass_lengths == b.pass_lengths && a.logicals == b.logicals &&
+                   a.physicals == b.physicals && a.dst_usage_bits == b.dst_usage_bits;
+        }
+
+        bool same_plans(const render_graph_system& a, const render_graph_system& b)
+        {
+            if (a.sorted_passes != b.sorted_passes || !same_barriers(a.per_pass_barriers, b.per_pass_barriers) ||
+                a.view_plans.size() != b.view_plans.size())
+            {
+                return false;
+            }
+            for (size_t view = 0; view < a.view_plans.size(); view++)
+            {
+                if (a.view_plans[view].sorted_passes != b.view_plans[view].sorted_passes ||
+                    !same_barriers(a.view_plans[view].per_pass_barriers, b.view_plans[view].per_pass_barriers))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    void job_system_test()
+    {
+        task_pool pool(4, 64);
+        assert(pool.worker_count() == 4);
+
+        // parallel_for from outside the pool.
+        std::atomic<uint64_t> sum{0};
+        pool.parallel_for(1000, [&](uint32_t i) { sum.fetch_add(i); });
+        assert(sum.load() == 999ULL * 1000ULL / 2ULL);
+
+        // Nested parallel_for: inner waits run on workers and must help instead of blocking.
+        std::atomic<uint32_t> inner{0};
+        pool.parallel_for(8, [&](uint32_t) { pool.parallel_for(50, [&](uint32_t) { inner.fetch_add(1); }); });
+        assert(inner.load() == 400);
+
+        // A worker submitting more jobs than its deque holds overflows into the injection queue.
+        std::atomic<uint32_t> children{0};
+        std::atomic<uint32_t> remaining{1 + 500};
+        pool.submit([&]
+                    {
+                        for (uint32_t i = 0; i < 500; i++)
+                        {
+                            pool.submit([&]
+                                        {
+                                            children.fetch_add(1);
+                                            remaining.fetch_sub(1);
+                                        });
+                        }
+                        remaining.fetch_sub(1);
+                    });
+        pool.wait(remaining);
+        assert(children.load() == 500);
+
+        // Reference plans without a job system.
+        graph_handles serial_handles;
+        render_graph_system serial;
+        build_graph(serial, serial_handles);
+        serial.compile();
+        assert(serial.view_plans.size() == 2);
+
+        // Pluggable job system: view plans and the three barrier plans are submitted as jobs.
+        inline_jobs engine_jobs;
+        graph_handles plugged_handles;
+        null_backend plugged_backend;
+        render_graph_system plugged;
+        build_graph(plugged, plugged_handles);
+        plugged.set_job_system(&engine_jobs);
+        plugged.set_backend(&plugged_backend);
+        plugged.compile();
+        assert(engine_jobs.submits == 2 + 3);
+        assert(same_plans(serial, plugged));
+
+        // execute_parallel() uses the system's job system.
+        plugged.execute_parallel();
+        assert(plugged_backend.applied.load() == plugged.sorted_passes.size());
+
+        // Several systems compiling at once as jobs of one shared pool.
+        constexpr uint32_t system_count = 4;
+        std::vector<graph_handles> handles(system_count);
+        std::vector<render_graph_system> systems(system_count);
+        for (uint32_t i = 0; i < system_count; i++)
+        {
+            build_graph(systems[i], handles[i]);
+            systems[i].set_job_system(&pool);
+        }
+        pool.parallel_for(system_count, [&](uint32_t i) { systems[i].compile(); });
+        for (const auto& system : systems)
+        {
+            assert(same_plans(serial, system));
+        }
+    }
+} // namespace render_graph::unit_test
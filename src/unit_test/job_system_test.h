@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks the task_pool (parallel_for, nested waits, deque overflow) and that compile and
+    // execute_parallel give the same plans through a pluggable job system, also for systems compiled concurrently.
+    void job_system_test();
+}
@@ -0,0 +1,201 @@
+#include "render_graph/unit_test/liveness_test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        constexpr uint32_t wide_output_count = 70;
+
+        struct test_state_t
+        {
+            resource_handle color    = 0;
+            resource_handle aux      = 0;
+            resource_handle ui       = 0;
+            resource_handle minimap  = 0;
+            resource_handle debug    = 0;
+            resource_handle fog_hist = 0;
+            resource_handle fog      = 0;
+
+            resource_handle base = 0;
+            std::vector<resource_handle> wide_outputs;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: lighting writes color and an auxiliary image only the debug pass reads.
+        void lighting_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+            s.aux = ctx.create_image(color_info("aux"));
+            ctx.write_image(s.aux, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: ui composites over color (output root 0).
+        void ui_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.ui = ctx.create_image(color_info("ui"));
+            ctx.write_image(s.ui, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.ui);
+        }
+
+        // Pass 2: minimap is independent of the scene (output root 1).
+        void minimap_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.minimap = ctx.create_image(color_info("minimap"));
+            ctx.write_image(s.minimap, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.minimap);
+        }
+
+        // Pass 3: debug view reads aux but feeds no output -> culled.
+        void debug_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.aux, image_usage::SAMPLED);
+            s.debug = ctx.create_image(color_info("debug"));
+            ctx.write_image(s.debug, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 4: fog reads last frame's fog history (output root 2).
+        void fog_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.fog_hist = ctx.create_image(color_info("fog_history"));
+            ctx.read_image_previous_frame(s.fog_hist, image_usage::SAMPLED);
+            s.fog = ctx.create_image(color_info("fog"));
+            ctx.write_image(s.fog, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.fog);
+        }
+
+        // Pass 5: writes the fog history for the next frame; only live through the history back edge.
+        void fog_history_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.write_image(s.fog_hist, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void build_scene(render_graph_system& system)
+        {
+            system.add_pass(lighting_setup, noop_execute);    // 0
+            system.add_pass(ui_setup, noop_execute);          // 1
+            system.add_pass(minimap_setup, noop_execute);     // 2
+            system.add_pass(debug_setup, noop_execute);       // 3
+            system.add_pass(fog_setup, noop_execute);         // 4
+            system.add_pass(fog_history_setup, noop_execute); // 5
+        }
+
+        // Pass 0 writes a shared base image; every other pass reads it and writes its own output.
+        void base_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.base = ctx.create_image(color_info("base"));
+            ctx.write_image(s.base, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void wide_output_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.base, image_usage::SAMPLED);
+            const auto output = ctx.create_image(color_info("wide_output"));
+            ctx.write_image(output, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(output);
+            s.wide_outputs.push_back(output);
+        }
+    } // namespace
+
+    void liveness_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        // Worklist and bitset engines agree on the culled set.
+        render_graph_system reference;
+        build_scene(reference);
+        reference.compile();
+
+        s.reset();
+        render_graph_system system;
+        system.set_bitset_liveness(true);
+        build_scene(system);
+        system.compile();
+
+        assert(system.active_pass_flags == reference.active_pass_flags);
+        assert(system.sorted_passes.size() == reference.sorted_passes.size());
+        assert(!system.active_pass_flags[3]);
+        assert(system.active_pass_flags[5]);
+
+        assert(system.liveness.root_count == 3);
+        assert(system.liveness.words_per_row == 1);
+
+        // Per-output queries.
+        const auto ui_set      = system.make_output_set({s.ui});
+        const auto minimap_set = system.make_output_set({s.minimap});
+        const auto fog_set     = system.make_output_set({s.fog});
+
+        assert(system.is_pass_live_for(0, ui_set));
+        assert(system.is_pass_live_for(1, ui_set));
+        assert(!system.is_pass_live_for(2, ui_set));
+        assert(!system.is_pass_live_for(0, minimap_set));
+        assert(system.is_pass_live_for(2, minimap_set));
+        assert(!system.is_pass_live_for(3, system.make_output_set({s.ui, s.minimap, s.fog})));
+
+        // History back edge: pass 5 comes after its reader and still picks up the fog root.
+        assert(system.is_pass_live_for(5, fog_set));
+        assert(!system.is_pass_live_for(5, ui_set));
+
+        // More roots than fit in one word.
+        s.reset();
+        render_graph_system wide;
+        wide.set_bitset_liveness(true);
+        wide.add_pass(base_setup, noop_execute);
+        for (uint32_t i = 0; i < wide_output_count; i++)
+        {
+            wide.add_pass(wide_output_setup, noop_execute);
+        }
+        wide.compile();
+
+        assert(wide.liveness.root_count == wide_output_count);
+        assert(wide.liveness.words_per_row == 2);
+        for (uint32_t root = 0; root < wide_output_count; root++)
+        {
+            assert(wide.liveness.test(0, root));
+        }
+
+        const auto high_set = wide.make_output_set({s.wide_outputs[66]});
+        assert(high_set.size() == 2 && high_set[0] == 0 && high_set[1] != 0);
+        assert(wide.is_pass_live_for(0, high_set));
+        assert(wide.is_pass_live_for(67, high_set));
+        assert(!wide.is_pass_live_for(66, high_set));
+        assert(!wide.is_pass_live_for(1, high_set));
+
+        (void)system;
+        (void)wide;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Bitset liveness: matches worklist culling, per-output-set queries across word boundaries and history back edges.
+    void liveness_test();
+}
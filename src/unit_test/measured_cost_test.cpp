@@ -0,0 +1,174 @@
+#include "render_graph/unit_test/measured_cost_test.h"
+
+#include <cassert>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle sky     = 0;
+            resource_handle ocean   = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        struct null_backend final : backend
+        {
+            void apply_barriers(pass_handle, const per_pass_barrier&) override { }
+        };
+
+        void noop_execute(pass_execute_context&) { }
+
+        void sky_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.sky = ctx.create_image(color_info("sky"));
+            ctx.write_image(s.sky, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void ocean_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.ocean = ctx.create_image(color_info("ocean"));
+            ctx.write_image(s.ocean, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.sky, image_usage::SAMPLED);
+            ctx.read_image(s.ocean, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+    } // namespace
+
+    void measured_cost_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        null_backend null;
+        render_graph_system system;
+        system.set_backend(&null);
+        system.set_critical_path_scheduling(true);
+        system.set_cost_smoothing(0.5F);
+
+        const auto sky   = system.add_pass(sky_setup, noop_execute);       // 0
+        const auto ocean = system.add_pass(ocean_setup, noop_execute);     // 1
+        system.add_pass(composite_setup, noop_execute);                    // 2
+        system.set_pass_name(sky, "sky");
+        system.set_pass_name(ocean, "ocean");
+
+        // Estimates favor the sky.
+        system.set_pass_cost(sky, 4.0F);
+        system.set_pass_cost(ocean, 2.0F);
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{0, 1, 2}));
+        assert(system.critical_path_length == 5.0F);
+
+        // Measurements say the ocean is the expensive one; the composite has no sample.
+        system.execute(nullptr, std::vector<float>{1.0F, 10.0F, -1.0F});
+        const auto* ocean_cost = system.measured_costs.find(system.pass_identity(ocean));
+        assert(ocean_cost != nullptr && *ocean_cost == 10.0F);
+        assert(system.measured_costs.find(system.pass_identity(2)) == nullptr);
+
+        // Smoothing: 10 -> 10 + 0.5 * (20 - 10).
+        system.execute(nullptr, std::vector<float>{1.0F, 20.0F, -1.0F});
+        assert(*system.measured_costs.find(system.pass_identity(ocean)) == 15.0F);
+
+        // Consumed on the next compile.
+        s.reset();
+        system.mark_all_passes_dirty();
+        system.compile();
+        assert((system.sorted_passes == std::vector<pass_handle>{1, 0, 2}));
+        assert(system.critical_path_length == 16.0F);
+
+        // A named pass keeps its measured cost when it is rebuilt under a new handle.
+        system.remove_pass(ocean);
+        const auto rebuilt = system.add_pass(ocean_setup, noop_execute);
+        system.set_pass_name(rebuilt, "ocean");
+        assert(system.pass_identity(rebuilt) == system.pass_identity(ocean));
+        assert(*system.measured_costs.find(system.pass_identity(rebuilt)) == 15.0F);
+
+        // Retained mode: a cost that drifted past the tolerance reschedules without any pass being dirty.
+        render_graph_system retained;
+        retained.set_backend(&null);
+        retained.set_critical_path_scheduling(true);
+        retained.set_cost_smoothing(0.5F);
+        retained.set_retained_mode(true);
+        retained.add_pass("sky", sky_setup, noop_execute);     // 0
+        retained.add_pass("ocean", ocean_setup, noop_execute); // 1
+        retained.add_pass(composite_setup, noop_execute);      // 2
+        retained.set_pass_cost(0, 4.0F);
+        retained.set_pass_cost(1, 2.0F);
+        retained.compile();
+        retained.execute(nullptr, std::vector<float>{4.0F, 2.0F, -1.0F});
+        retained.compile();
+        assert((retained.sorted_passes == std::vector<pass_handle>{0, 1, 2}));
+
+        // Within the tolerance (2 -> 2.05): the revision stays and the schedule is kept.
+        const auto revision = retained.measured_costs.revision;
+        retained.execute(nullptr, std::vector<float>{4.0F, 2.1F, -1.0F});
+        assert(retained.measured_costs.revision == revision);
+        assert(*retained.measured_costs.find(retained.pass_identity(1)) == 2.0F);
+
+        const auto structure = retained.structural_hash();
+        retained.execute(nullptr, std::vector<float>{4.0F, 20.0F, -1.0F});
+        assert(retained.measured_costs.revision == revision + 1);
+        assert(retained.structural_hash() == structure);
+        retained.compile();
+        assert(retained.last_setup_invocations == 0);
+        assert((retained.sorted_passes == std::vector<pass_handle>{1, 0, 2}));
+
+        // Variant cache: costs are not part of the key. A drift reschedules a hit in place, so every cached
+        // variant stays reachable.
+        render_graph_system variants;
+        variants.set_backend(&null);
+        variants.set_critical_path_scheduling(true);
+        variants.set_cost_smoothing(0.5F);
+        variants.add_pass("sky", sky_setup, noop_execute);     // 0
+        variants.add_pass("ocean", ocean_setup, noop_execute); // 1
+        variants.add_pass(composite_setup, noop_execute);      // 2
+        variants.set_pass_cost(0, 4.0F);
+        variants.set_pass_cost(1, 2.0F);
+        variants.compile_variant(0);
+        variants.compile_variant(1);
+        variants.compile_variant(0);
+        assert(variants.variant_cache.hits == 1 && variants.variant_cache.misses == 2);
+        assert((variants.sorted_passes == std::vector<pass_handle>{0, 1, 2}));
+
+        variants.execute(nullptr, std::vector<float>{1.0F, 10.0F, -1.0F});
+        variants.compile_variant(0);
+        assert(variants.variant_cache.hits == 2 && variants.variant_cache.misses == 2);
+        assert((variants.sorted_passes == std::vector<pass_handle>{1, 0, 2}));
+        variants.compile_variant(1);
+        assert(variants.variant_cache.hits == 3 && variants.variant_cache.misses == 2);
+        assert((variants.sorted_passes == std::vector<pass_handle>{1, 0, 2}));
+
+        // The rescheduled entry was stored back: the next hit loads it as is.
+        variants.compile_variant(0);
+        assert(variants.variant_cache.hits == 4);
+        assert(!variants.costs_changed());
+        assert((variants.sorted_passes == std::vector<pass_handle>{1, 0, 2}));
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
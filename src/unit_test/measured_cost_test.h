@@ -0,0 +1,9 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Measured costs: execute() feeds smoothed per-pass durations back into critical-path scheduling, including
+    // retained-mode compiles and cached variants, which reschedule without rerunning setup once a cost drifted past
+    // the tolerance.
+    void measured_cost_test();
+}
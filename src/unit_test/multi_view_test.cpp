@@ -0,0 +1,192 @@
+#include "render_graph/unit_test/multi_view_test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        constexpr view_mask main_view  = 1U << 0;
+        constexpr view_mask probe_view = 1U << 1;
+        constexpr view_mask pip_view   = 1U << 2;
+
+        struct test_state_t
+        {
+            resource_handle lut        = 0;
+            resource_handle main_color = 0;
+            resource_handle probe      = 0;
+            resource_handle pip        = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        // Records the order in which passes get their barriers applied.
+        struct order_backend final : backend
+        {
+            std::vector<pass_handle> applied;
+            std::vector<uint32_t> applied_frames; // frame-in-flight slot each applied pass resolved to
+            std::vector<uint32_t> begun_frames;
+
+            void on_begin_frame(uint32_t frame_in_flight) override { begun_frames.push_back(frame_in_flight); }
+
+            void apply_barriers(pass_handle pass, const per_pass_barrier&) override
+            {
+                applied.push_back(pass);
+                applied_frames.push_back(begun_frames.back());
+            }
+        };
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: shared lookup table, rendered once for every view.
+        void lut_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.lut = ctx.create_image(color_info("lut", image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED | image_usage::STORAGE));
+            ctx.write_image(s.lut, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: main view samples the lut.
+        void main_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.lut, image_usage::SAMPLED);
+            s.main_color = ctx.create_image(color_info("main", image_usage::COLOR_ATTACHMENT));
+            ctx.write_image(s.main_color, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.main_color, main_view);
+        }
+
+        // Pass 2: reflection probe reads the lut as storage.
+        void probe_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.lut, image_usage::STORAGE);
+            s.probe = ctx.create_image(color_info("probe", image_usage::COLOR_ATTACHMENT));
+            ctx.write_image(s.probe, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.probe, probe_view);
+        }
+
+        // Pass 3: picture-in-picture composites the main view; shown in the main and pip views.
+        void pip_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.main_color, image_usage::SAMPLED);
+            s.pip = ctx.create_image(color_info("pip", image_usage::COLOR_ATTACHMENT));
+            ctx.write_image(s.pip, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.pip, main_view | pip_view);
+        }
+
+        void build(render_graph_system& system)
+        {
+            system.add_pass(lut_setup, noop_execute);   // 0
+            system.add_pass(main_setup, noop_execute);  // 1
+            system.add_pass(probe_setup, noop_execute); // 2
+            system.add_pass(pip_setup, noop_execute);   // 3
+        }
+
+        // Source usage of the lut transition applied before the probe pass.
+        uint32_t probe_lut_src_usage(const per_pass_barrier& plan)
+        {
+            const auto& s    = test_state();
+            const auto begin = plan.pass_begins[2];
+            for (auto i = begin; i < begin + plan.pass_lengths[2]; i++)
+            {
+                if (plan.types[i] == barrier_op_type::transition && plan.logicals[i] == s.lut)
+                {
+                    return plan.src_usage_bits[i];
+                }
+            }
+            assert(false && "missing lut transition");
+            return 0;
+        }
+    } // namespace
+
+    void multi_view_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        // Merged: one combined schedule, per-view subsets for inspection only.
+        render_graph_system merged;
+        merged.set_views(3);
+        build(merged);
+        merged.compile();
+
+        assert(merged.sorted_passes.size() == 4);
+        assert(merged.view_plans.size() == 3);
+        assert((merged.view_plans[0].sorted_passes == std::vector<pass_handle>{0, 1, 3}));
+        assert((merged.view_plans[1].sorted_passes == std::vector<pass_handle>{0, 2}));
+        assert((merged.view_plans[2].sorted_passes == std::vector<pass_handle>{0, 1, 3}));
+        assert(merged.view_plans[1].active_pass_flags[2] && !merged.view_plans[1].active_pass_flags[1]);
+        assert(merged.view_plans[0].per_pass_barriers.pass_begins.empty());
+
+        // In the merged schedule the probe pass follows the main pass' sampled read.
+        assert(probe_lut_src_usage(merged.per_pass_barriers) == static_cast<uint32_t>(image_usage::SAMPLED));
+
+        // Separate: each view transitions from the last use within its own schedule.
+        s.reset();
+        order_backend order;
+        render_graph_system separate;
+        separate.set_backend(&order);
+        separate.set_views(3, false);
+        separate.set_frames_in_flight(2);
+        build(separate);
+        separate.compile();
+
+        assert(separate.view_plans.size() == 3);
+        const auto& probe_plan = separate.view_plans[1];
+        assert(probe_plan.per_pass_barriers.pass_begins.size() == 5);
+        assert(probe_lut_src_usage(probe_plan.per_pass_barriers) == static_cast<uint32_t>(image_usage::COLOR_ATTACHMENT));
+
+        separate.execute_view(1);
+        assert((order.applied == std::vector<pass_handle>{0, 2}));
+
+        order.applied.clear();
+        separate.execute_view(0);
+        assert((order.applied == std::vector<pass_handle>{0, 1, 3}));
+
+        // Views executed back to back share one frame: one on_begin_frame, one frame-in-flight slot. Executing a
+        // view again begins the next frame, as does an explicit begin_frame().
+        assert((order.begun_frames == std::vector<uint32_t>{0}));
+        order.applied_frames.clear();
+        separate.execute_view(0);
+        separate.execute_view(1);
+        assert((order.begun_frames == std::vector<uint32_t>{0, 1}));
+        separate.begin_frame();
+        separate.execute_view(0);
+        separate.execute_view(1);
+        assert((order.begun_frames == std::vector<uint32_t>{0, 1, 0}));
+        assert((order.applied_frames == std::vector<uint32_t>{1, 1, 1, 1, 1, 0, 0, 0, 0, 0}));
+
+        // A whole-schedule execute after views begins its own frame.
+        separate.execute();
+        assert((order.begun_frames == std::vector<uint32_t>{0, 1, 0, 1}));
+
+        // Single view: no per-view plans.
+        s.reset();
+        render_graph_system single;
+        build(single);
+        single.compile();
+        assert(single.view_plans.empty());
+        assert(single.sorted_passes.size() == 4);
+
+        (void)merged;
+        (void)separate;
+        (void)single;
+    }
+} // namespace render_graph::unit_test
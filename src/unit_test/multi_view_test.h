@@ -0,0 +1,7 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Multi-view: per-view pass subsets/schedules from one compile, merged vs separate barrier plans, views sharing a frame.
+    void multi_view_test();
+}
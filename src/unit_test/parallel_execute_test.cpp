@@ -0,0 +1,247 @@
+#include "render_graph/unit_test/parallel_execute_test.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+
+#include "render_graph/system.h"
+#include "render_graph/task_pool.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        constexpr uint32_t fan_out    = 8;
+        constexpr uint32_t pass_total = fan_out + 3; // root, fan-out passes, join, culled
+
+        struct test_state_t
+        {
+            resource_handle seed   = 0;
+            resource_handle joined = 0;
+            resource_handle unused = 0;
+            std::array<resource_handle, fan_out> partials{};
+
+            std::atomic<uint32_t> ticket{1};
+            std::array<std::atomic<uint32_t>, pass_total> barrier_tickets{};
+            std::array<std::atomic<uint32_t>, pass_total> begin_tickets{};
+            std::array<std::atomic<uint32_t>, pass_total> end_tickets{};
+            std::array<std::atomic<uint32_t>, pass_total> runs{};
+
+            void reset()
+            {
+                ticket.store(1);
+                for (uint32_t i = 0; i < pass_total; i++)
+                {
+                    barrier_tickets[i].store(0);
+                    begin_tickets[i].store(0);
+                    end_tickets[i].store(0);
+                    runs[i].store(0);
+                }
+            }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        struct ticket_backend final : backend
+        {
+            void apply_barriers(pass_handle pass, const per_pass_barrier&) override
+            {
+                auto& s = test_state();
+                s.barrier_tickets[pass].store(s.ticket.fetch_add(1));
+            }
+        };
+
+        auto timed_execute(pass_handle pass)
+        {
+            return [pass](pass_execute_context&)
+            {
+                auto& s = test_state();
+                s.begin_tickets[pass].store(s.ticket.fetch_add(1));
+                s.runs[pass].fetch_add(1);
+                std::this_thread::yield();
+                s.end_tickets[pass].store(s.ticket.fetch_add(1));
+            };
+        }
+    } // namespace
+
+    void parallel_execute_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        ticket_backend backend_impl;
+        render_graph_system system;
+        system.set_backend(&backend_impl);
+
+        // 0: root
+        system.add_pass(
+            [](pass_setup_context& ctx)
+            {
+                auto& s = test_state();
+                s.seed  = ctx.create_buffer(storage_info("seed"));
+                ctx.write_buffer(s.seed, buffer_usage::STORAGE_BUFFER);
+            },
+            timed_execute(0));
+
+        // 1..fan_out: independent passes reading the seed
+        for (uint32_t i = 0; i < fan_out; i++)
+        {
+            system.add_pass(
+                [i](pass_setup_context& ctx)
+                {
+                    auto& s = test_state();
+                    ctx.read_buffer(s.seed, buffer_usage::STORAGE_BUFFER);
+                    s.partials[i] = ctx.create_buffer(storage_info("partial"));
+                    ctx.write_buffer(s.partials[i], buffer_usage::STORAGE_BUFFER);
+                },
+                timed_execute(i + 1));
+        }
+
+        // fan_out + 1: join
+        system.add_pass(
+            [](pass_setup_context& ctx)
+            {
+                auto& s = test_state();
+                for (const auto partial : s.partials)
+                {
+                    ctx.read_buffer(partial, buffer_usage::STORAGE_BUFFER);
+                }
+                s.joined = ctx.create_buffer(storage_info("joined"));
+                ctx.write_buffer(s.joined, buffer_usage::STORAGE_BUFFER);
+                ctx.declare_buffer_output(s.joined);
+            },
+            timed_execute(fan_out + 1));
+
+        // fan_out + 2: culled (contributes to nothing)
+        system.add_pass(
+            [](pass_setup_context& ctx)
+            {
+                auto& s  = test_state();
+                s.unused = ctx.create_buffer(storage_info("unused"));
+                ctx.write_buffer(s.unused, buffer_usage::STORAGE_BUFFER);
+            },
+            timed_execute(fan_out + 2));
+
+        system.compile();
+        assert(system.sorted_passes.size() == fan_out + 2);
+
+        task_pool pool(4);
+        assert(pool.worker_count() == 4);
+
+        for (uint32_t frame = 0; frame < 16; frame++)
+        {
+            s.reset();
+            system.execute_parallel(pool);
+
+            assert(s.runs[fan_out + 2].load() == 0);
+            for (uint32_t pass = 0; pass < fan_out + 2; pass++)
+            {
+                assert(s.runs[pass].load() == 1);
+                assert(s.barrier_tickets[pass].load() < s.begin_tickets[pass].load());
+            }
+
+            // Every edge: the predecessor finished before the successor's barriers were applied.
+            const auto& dag = system.dag;
+            for (pass_handle pass = 0; pass < fan_out + 2; pass++)
+            {
+                for (auto i = dag.adjacency_begins[pass]; i < dag.adjacency_begins[pass + 1]; i++)
+                {
+                    assert(s.end_tickets[pass].load() < s.barrier_tickets[dag.adjacency_list[i]].load());
+                }
+            }
+            assert(s.end_tickets[0].load() < s.begin_tickets[1].load());
+            assert(s.end_tickets[fan_out].load() < s.begin_tickets[fan_out + 1].load());
+        }
+
+        // With a tracer, every pass records its barrier and execute spans as in execute().
+        trace_recorder recorder;
+        system.set_tracer(&recorder);
+        s.reset();
+        system.execute_parallel(pool);
+        system.set_tracer(nullptr);
+        assert(recorder.events.size() == 2 * (fan_out + 2));
+        for (uint32_t pass = 0; pass < fan_out + 2; pass++)
+        {
+            const auto label  = "pass " + std::to_string(pass);
+            uint32_t execute  = 0;
+            uint32_t barriers = 0;
+            for (const auto& e : recorder.events)
+            {
+                execute += (e.name == label && e.category == "execute") ? 1U : 0U;
+                barriers += (e.name == label + " barriers" && e.category == "barriers") ? 1U : 0U;
+            }
+            assert(execute == 1 && barriers == 1);
+        }
+
+        // Spans go to the track of the thread that ran the pass, so no two spans of a track overlap.
+        for (const auto& a : recorder.events)
+        {
+            assert(a.track >= trace_recorder::first_thread_track);
+            for (const auto& b : recorder.events)
+            {
+                if (&a != &b && a.track == b.track)
+                {
+                    // Back-to-back spans (barriers, then execute) may differ by rounding.
+                    assert(a.begin_us + a.duration_us <= b.begin_us + 0.001 || b.begin_us + b.duration_us <= a.begin_us + 0.001);
+                }
+            }
+        }
+        assert(recorder.to_chrome_json().find("\"CPU worker 0\"") != std::string::npos);
+
+        // Two independent passes whose scratch buffers alias one physical buffer run in schedule order even
+        // though the DAG does not order them.
+        render_graph_system aliased;
+        aliased.set_backend(&backend_impl);
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            aliased.add_pass(
+                [i](pass_setup_context& ctx)
+                {
+                    auto& s       = test_state();
+                    s.partials[i] = ctx.create_buffer(storage_info("scratch"));
+                    ctx.write_buffer(s.partials[i], buffer_usage::STORAGE_BUFFER);
+                    s.partials[i + 2] = ctx.create_buffer(storage_info("result"));
+                    ctx.write_buffer(s.partials[i + 2], buffer_usage::STORAGE_BUFFER);
+                },
+                timed_execute(i));
+        }
+        aliased.add_pass(
+            [](pass_setup_context& ctx)
+            {
+                auto& s = test_state();
+                ctx.read_buffer(s.partials[2], buffer_usage::STORAGE_BUFFER);
+                ctx.read_buffer(s.partials[3], buffer_usage::STORAGE_BUFFER);
+                s.joined = ctx.create_buffer(storage_info("joined"));
+                ctx.write_buffer(s.joined, buffer_usage::STORAGE_BUFFER);
+                ctx.declare_buffer_output(s.joined);
+            },
+            timed_execute(2));
+        aliased.compile();
+
+        const auto& physical_ids = aliased.physical_resource_metas.handle_to_physical_buf_id;
+        assert(physical_ids[s.partials[0]] == physical_ids[s.partials[1]]);
+        const auto first  = aliased.sorted_passes[0];
+        const auto second = aliased.sorted_passes[1];
+        for (auto i = aliased.dag.adjacency_begins[first]; i < aliased.dag.adjacency_begins[first + 1]; i++)
+        {
+            assert(aliased.dag.adjacency_list[i] != second);
+        }
+
+        for (uint32_t frame = 0; frame < 64; frame++)
+        {
+            s.reset();
+            aliased.execute_parallel(pool);
+            assert(s.end_tickets[first].load() < s.barrier_tickets[second].load());
+            assert(s.end_tickets[second].load() < s.barrier_tickets[2].load());
+        }
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
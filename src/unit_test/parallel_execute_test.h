@@ -0,0 +1,9 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks that execute_parallel runs every live pass exactly once, never before its DAG
+    // predecessors or an earlier user of an aliased physical resource, and applies each pass's barriers
+    // before it runs and records its trace spans on the track of the thread that ran it.
+    void parallel_execute_test();
+}
@@ -0,0 +1,159 @@
+#include "render_graph/unit_test/pipelined_compile_test.h"
+
+#include <cassert>
+#include <vector>
+
+#include "render_graph/recording_backend.h"
+#include "render_graph/system.h"
+#include "render_graph/task_pool.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle depth  = 0;
+            resource_handle color  = 0;
+            resource_handle bloom  = 0;
+            resource_handle output = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: depth prepass.
+        void depth_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.depth = ctx.create_image(color_info("depth"));
+            ctx.write_image(s.depth, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: forward shading.
+        void color_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.depth, image_usage::SAMPLED);
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: bloom, a second output (toggled between frames).
+        void bloom_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.bloom = ctx.create_image(color_info("bloom"));
+            ctx.write_image(s.bloom, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.bloom);
+        }
+
+        // Pass 3: composite.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.output = ctx.create_image(color_info("output"));
+            ctx.write_image(s.output, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.output);
+        }
+    } // namespace
+
+    void pipelined_compile_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        task_pool pool(2);
+        recording_backend recorder;
+        render_graph_system system;
+        system.set_backend(&recorder);
+        system.set_job_system(&pool);
+        system.set_retained_mode(true);
+        system.set_pipelined_compile(true);
+
+        // Enabling before the first compile leaves nothing to publish.
+        system.swap_plans();
+        assert(system.plan_swaps == 0 && recorder.stats.compiles == 0);
+
+        system.add_pass(depth_setup, noop_execute);                    // 0
+        system.add_pass(color_setup, noop_execute);                    // 1
+        const auto bloom = system.add_pass(bloom_setup, noop_execute); // 2
+        system.add_pass(composite_setup, noop_execute);                // 3
+
+        // The first plan reaches the backend only at the swap.
+        system.begin_compile();
+        system.wait_for_compile();
+        assert(recorder.stats.compiles == 0);
+        assert(system.front_plan.sorted_passes.empty());
+        system.swap_plans();
+        assert(recorder.stats.compiles == 1 && system.plan_swaps == 1);
+        assert(system.front_plan.sorted_passes == system.sorted_passes);
+        const auto front_before = system.front_plan.sorted_passes;
+        const auto front_size   = front_before.size();
+
+        // Frame N executes the front plan while frame N+1 compiles a graph without bloom.
+        system.set_pass_enabled(bloom, false);
+        system.begin_compile();
+        auto logged = recorder.pass_log.size();
+        system.execute();
+        assert(recorder.pass_log.size() - logged == front_size);
+        system.wait_for_compile();
+        assert(system.sorted_passes.size() < front_size);
+        assert(system.front_plan.sorted_passes == front_before);
+        assert(recorder.stats.compiles == 1);
+        assert(system.back_plan.sorted_passes == system.sorted_passes);
+
+        // Measured durations of the frame are recorded at the swap, not during the in-flight compile.
+        const std::vector<float> durations(4, 2.0F);
+        system.execute(nullptr, durations);
+        assert(system.measured_costs.find(system.pass_identity(0)) == nullptr);
+
+        // The swap exchanges the plans instead of copying the back plan.
+        const auto* published = system.back_plan.sorted_passes.data();
+        system.swap_plans();
+        assert(system.front_plan.sorted_passes.data() == published);
+        assert(system.back_plan.sorted_passes == front_before);
+        assert(recorder.stats.compiles == 2 && system.plan_swaps == 2);
+        assert(system.measured_costs.find(system.pass_identity(0)) != nullptr);
+        assert(system.front_plan.sorted_passes == system.sorted_passes);
+
+        logged = recorder.pass_log.size();
+        system.execute();
+        assert(recorder.pass_log.size() - logged == system.sorted_passes.size());
+
+        // Nothing changed: the retained compile returns early and the swap keeps the front plan.
+        system.begin_compile();
+        system.swap_plans();
+        assert(system.plan_swaps == 2 && recorder.stats.compiles == 2);
+
+        // Without a job system begin_compile() compiles inline.
+        system.set_job_system(nullptr);
+        system.set_pass_enabled(bloom, true);
+        system.begin_compile();
+        assert(system.sorted_passes.size() == front_size);
+        system.swap_plans();
+        assert(system.plan_swaps == 3 && system.front_plan.sorted_passes == front_before);
+
+        // Leaving pipelined mode executes the compiled members again.
+        system.set_pipelined_compile(false);
+        logged = recorder.pass_log.size();
+        system.execute();
+        assert(recorder.pass_log.size() - logged == front_size);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks that execution reads the front plan while the back plan recompiles on a job system, and that
+    // swap_plans() publishes it: backend allocation, deferred measured durations and plan_swaps.
+    void pipelined_compile_test();
+}
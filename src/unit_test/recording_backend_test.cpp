@@ -0,0 +1,136 @@
+#include "render_graph/unit_test/recording_backend_test.h"
+
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "render_graph/recording_backend.h"
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle scene      = 0;
+            resource_handle backbuffer = 0;
+            resource_handle counts     = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene color + a storage buffer.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.scene = ctx.create_image(color_info("scene"));
+            ctx.write_image(s.scene, image_usage::COLOR_ATTACHMENT);
+
+            s.counts = ctx.create_buffer(buffer_info{
+                .name     = "counts",
+                .size     = 1024,
+                .usage    = buffer_usage::STORAGE_BUFFER,
+                .imported = false,
+            });
+            ctx.write_buffer(s.counts, buffer_usage::STORAGE_BUFFER);
+        }
+
+        // Pass 1: samples the scene and writes the imported backbuffer.
+        void present_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.scene, image_usage::SAMPLED);
+            ctx.read_buffer(s.counts, buffer_usage::STORAGE_BUFFER);
+            auto backbuffer_info     = color_info("backbuffer");
+            backbuffer_info.imported = true;
+            s.backbuffer             = ctx.create_image(backbuffer_info);
+            ctx.write_image(s.backbuffer, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.backbuffer);
+        }
+    } // namespace
+
+    void recording_backend_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        recording_backend recorder;
+        render_graph_system system;
+        system.set_backend(&recorder);
+        system.add_pass("scene", scene_setup, noop_execute);     // 0
+        system.add_pass("present", present_setup, noop_execute); // 1
+        system.compile();
+
+        // Scene image + counts buffer are allocated; the imported backbuffer is not.
+        assert(recorder.stats.compiles == 1);
+        assert(recorder.allocation_log.size() == 2);
+        assert(recorder.stats.allocations == 2);
+        assert(recorder.allocation_log[0].kind == resource_kind::image && recorder.allocation_log[0].logical == s.scene);
+        assert(recorder.allocation_log[1].kind == resource_kind::buffer && recorder.allocation_log[1].size == 1024);
+
+        recorder.bind_imported_image(s.backbuffer, 0x1000, 0x2000);
+        system.execute();
+        system.execute();
+
+        // Two frames of two passes; the logged ops are the compiled plan's.
+        assert(recorder.stats.frames == 2);
+        assert(recorder.stats.passes == 4);
+        assert(recorder.pass_log.size() == 4);
+        assert(recorder.pass_log[2].frame == 1 && recorder.pass_log[2].pass == 0);
+        const auto& plan = system.per_pass_barriers;
+        uint64_t planned = 0;
+        for (const auto& p : recorder.pass_log)
+        {
+            assert(p.barrier_count == plan.pass_lengths[p.pass]);
+            for (uint32_t i = 0; i < p.barrier_count; i++)
+            {
+                const auto& op = recorder.barrier_ops[p.barrier_begin + i];
+                assert(op.logical == plan.logicals[plan.pass_begins[p.pass] + i]);
+                assert(op.dst_usage_bits == plan.dst_usage_bits[plan.pass_begins[p.pass] + i]);
+            }
+            planned += p.barrier_count;
+        }
+        assert(planned > 0 && recorder.stats.barrier_ops == planned);
+
+        // Text form names resources and passes instead of handles.
+        const auto text = recorder.to_text();
+        assert(text.find("alloc image slot 0 physical 0 scene\n") != std::string::npos);
+        assert(text.find("alloc buffer slot 0 physical 0 counts size 1024\n") != std::string::npos);
+        assert(text.find("bind image backbuffer native 4096 view 8192\n") != std::string::npos);
+        assert(text.find("frame 1 pass 1 present\n") != std::string::npos);
+        assert(text.find("transition image scene physical 0 ") != std::string::npos);
+
+        // Golden round trip.
+        const auto path = (std::filesystem::temp_directory_path() / "render_graph_recording_backend_test.txt").string();
+        assert(recorder.write_golden(path));
+        std::string diff;
+        assert(recorder.matches_golden(path, &diff) && diff.empty());
+        system.execute();
+        assert(!recorder.matches_golden(path, &diff));
+        assert(diff.find("expected \"<eof>\", got \"frame 2 pass 0 scene\"") != std::string::npos);
+        std::remove(path.c_str());
+        assert(!recorder.matches_golden(path, &diff));
+
+        // Logging off: counters only.
+        recorder.clear_log();
+        recorder.set_logging(false);
+        system.execute();
+        assert(recorder.stats.frames == 1 && recorder.stats.passes == 2 && recorder.stats.barrier_ops == plan.pass_lengths[0] + plan.pass_lengths[1]);
+        assert(recorder.pass_log.empty() && recorder.barrier_ops.empty());
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks that the recording backend logs the compiled plan (allocations, bindings, per-pass
+    // barriers), its counters, logging off, and the golden-file round trip.
+    void recording_backend_test();
+}
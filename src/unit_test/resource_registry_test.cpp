@@ -0,0 +1,128 @@
+#include "render_graph/unit_test/resource_registry_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            bool enable_bloom = true;
+            bool enable_fog   = false;
+
+            resource_handle color   = 0;
+            resource_handle blur_a  = 0;
+            resource_handle blur_b  = 0;
+            resource_handle bloom   = 0;
+            resource_handle fog     = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene color plus two blur targets sharing one name (distinguished by declaration order).
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+
+            s.blur_a = ctx.create_image(color_info("blur"));
+            s.blur_b = ctx.create_image(color_info("blur"));
+            ctx.write_image(s.blur_a, image_usage::COLOR_ATTACHMENT);
+            ctx.write_image(s.blur_b, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: optional effects declare their resources only when enabled.
+        void effects_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            if (s.enable_bloom)
+            {
+                s.bloom = ctx.create_image(color_info("bloom"));
+                ctx.write_image(s.bloom, image_usage::COLOR_ATTACHMENT);
+            }
+            if (s.enable_fog)
+            {
+                s.fog = ctx.create_image(color_info("fog"));
+                ctx.write_image(s.fog, image_usage::COLOR_ATTACHMENT);
+            }
+
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+    } // namespace
+
+    void resource_registry_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.add_pass(scene_setup, noop_execute);   // 0
+        system.add_pass(effects_setup, noop_execute); // 1
+
+        system.compile();
+
+        const auto& images   = system.meta_table.image_metas;
+        const auto& registry = system.meta_table.image_registry;
+        assert(images.names.size() == 5);
+        assert(s.blur_a != s.blur_b);
+
+        const auto color   = s.color;
+        const auto blur_a  = s.blur_a;
+        const auto blur_b  = s.blur_b;
+        const auto bloom   = s.bloom;
+        const auto final_c = s.final_c;
+
+        // Recompiling the same graph re-declares every resource: same handles, no growth.
+        system.compile();
+        assert(images.names.size() == 5);
+        assert(s.color == color && s.blur_a == blur_a && s.blur_b == blur_b && s.bloom == bloom && s.final_c == final_c);
+
+        // Bloom disappears: its handle is released, the others keep theirs.
+        s.enable_bloom = false;
+        system.compile();
+        assert(!registry.is_alive(bloom));
+        assert(registry.is_alive(final_c));
+        assert(s.final_c == final_c && s.color == color);
+        assert(system.physical_resource_metas.handle_to_physical_img_id[bloom] == std::numeric_limits<uint32_t>::max());
+
+        // A new resource recycles the released handle; the tables stay bounded.
+        s.enable_fog = true;
+        system.compile();
+        assert(s.fog == bloom);
+        assert(images.names[s.fog] == "fog");
+        assert(images.names.size() == 5);
+
+        // Toggling back and forth keeps handles stable and the tables bounded: handles are released at the end
+        // of a compile, so a swap within one compile needs one extra slot at most.
+        for (int i = 0; i < 8; i++)
+        {
+            s.enable_bloom = (i % 2) == 0;
+            s.enable_fog   = !s.enable_bloom;
+            system.compile();
+            assert(s.final_c == final_c);
+            assert(images.names.size() <= 6);
+        }
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
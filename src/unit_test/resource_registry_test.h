@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies stable resource handles across recompiles: re-declared resources keep their handle,
+    // undeclared ones are released and recycled, and the meta tables stay bounded.
+    void resource_registry_test();
+}
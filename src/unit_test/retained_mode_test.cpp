@@ -0,0 +1,140 @@
+#include "render_graph/unit_test/retained_mode_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct frame_params
+        {
+            uint32_t frame_index = 0;
+        };
+
+        struct test_state_t
+        {
+            uint32_t scene_setup_calls = 0;
+            uint32_t post_setup_calls  = 0;
+            uint32_t last_frame_index  = 0;
+
+            bool use_depth = false;
+
+            resource_handle color   = 0;
+            resource_handle depth   = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        struct null_backend final : backend
+        {
+            void apply_barriers(pass_handle, const per_pass_barrier&) override { }
+        };
+
+        void noop_execute(pass_execute_context&) { }
+
+        void post_execute(pass_execute_context& ctx)
+        {
+            const auto* params = ctx.params<frame_params>();
+            assert(params != nullptr);
+            test_state().last_frame_index = params->frame_index;
+        }
+
+        // Pass 0: static scene declarations.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.scene_setup_calls++;
+
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: post; optionally samples a depth image it creates itself.
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.post_setup_calls++;
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            if (s.use_depth)
+            {
+                s.depth = ctx.create_image(color_info("depth_copy"));
+                ctx.write_image(s.depth, image_usage::COLOR_ATTACHMENT);
+            }
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+    } // namespace
+
+    void retained_mode_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        null_backend null;
+        render_graph_system system;
+        system.set_backend(&null);
+        system.set_retained_mode(true);
+        system.add_pass(scene_setup, noop_execute); // 0
+        system.add_pass(post_setup, post_execute);  // 1
+
+        system.compile();
+        assert(s.scene_setup_calls == 1 && s.post_setup_calls == 1);
+        const auto reads   = system.image_read_deps.read_list;
+        const auto writes  = system.image_write_deps.write_list;
+        const auto sorted  = system.sorted_passes;
+        const auto barriers = system.per_pass_barriers.types.size();
+
+        // Nothing dirty: compile is a no-op, frames only run execute with their parameters.
+        for (uint32_t frame = 1; frame <= 3; frame++)
+        {
+            system.compile();
+            frame_params params{.frame_index = frame};
+            system.execute(&params);
+            assert(s.last_frame_index == frame);
+        }
+        assert(s.scene_setup_calls == 1 && s.post_setup_calls == 1);
+
+        // Dirty post pass: only its setup runs; the scene pass is replayed with the same handles.
+        s.use_depth = true;
+        system.mark_pass_dirty(1);
+        system.compile();
+        assert(s.scene_setup_calls == 1 && s.post_setup_calls == 2);
+        assert(system.meta_table.image_registry.is_alive(s.color));
+        assert(system.meta_table.image_registry.is_alive(s.depth));
+        assert(system.image_write_deps.lengthes[0] == 1 && system.image_write_deps.write_list[0] == s.color);
+        assert(system.image_write_deps.lengthes[1] == 2);
+
+        // Reverting the post pass reproduces the original tables.
+        s.use_depth = false;
+        system.mark_pass_dirty(1);
+        system.compile();
+        assert(s.scene_setup_calls == 1 && s.post_setup_calls == 3);
+        assert(!system.meta_table.image_registry.is_alive(s.depth));
+        assert(system.image_read_deps.read_list == reads);
+        assert(system.image_write_deps.write_list == writes);
+        assert(system.sorted_passes == sorted);
+        assert(system.per_pass_barriers.types.size() == barriers);
+        assert(system.output_table.image_outputs.size() == 1);
+
+        // Structural changes (frames in flight) recompile but still replay clean passes.
+        system.set_frames_in_flight(2);
+        system.compile();
+        assert(s.scene_setup_calls == 1 && s.post_setup_calls == 3);
+        assert(system.physical_resource_metas.frames_in_flight == 2);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies retained mode: clean passes are replayed without invoking setup, dirty passes re-run,
+    // unchanged graphs skip compile, and per-frame parameters reach execute functions.
+    void retained_mode_test();
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks the simulated timeline: queue overlap, cross-queue waits, barrier costs,
+    // idle bubbles and utilization.
+    void simulator_backend_test();
+}
@@ -0,0 +1,154 @@
+#include "render_graph/unit_test/stable_aliasing_test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            bool enable_bloom = true;
+
+            resource_handle color   = 0;
+            resource_handle bloom   = 0;
+            resource_handle post    = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene color.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.color = ctx.create_image(color_info("color", format::R8G8B8A8_UNORM));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: optional bloom; declares nothing (and is culled) when disabled.
+        void bloom_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            if (!s.enable_bloom)
+            {
+                return;
+            }
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.bloom = ctx.create_image(color_info("bloom", format::R8G8B8A8_UNORM));
+            ctx.write_image(s.bloom, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: post combines color (and bloom).
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            if (s.enable_bloom)
+            {
+                ctx.read_image(s.bloom, image_usage::SAMPLED);
+            }
+            s.post = ctx.create_image(color_info("post", format::R8G8B8A8_UNORM));
+            ctx.write_image(s.post, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: final output in a different format (never aliased with the others).
+        void final_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.post, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final", format::B8G8R8A8_UNORM));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        void build(render_graph_system& system)
+        {
+            system.add_pass(scene_setup, noop_execute); // 0
+            system.add_pass(bloom_setup, noop_execute); // 1
+            system.add_pass(post_setup, noop_execute);  // 2
+            system.add_pass(final_setup, noop_execute); // 3
+        }
+
+        uint32_t physical_of(const render_graph_system& system, resource_handle logical)
+        {
+            return system.physical_resource_metas.handle_to_physical_img_id[logical];
+        }
+    } // namespace
+
+    void stable_aliasing_test()
+    {
+        auto& s = test_state();
+        const auto invalid = std::numeric_limits<resource_handle>::max();
+
+        // Greedy first-fit: disabling bloom shifts post and final down.
+        {
+            s.reset();
+            render_graph_system system;
+            build(system);
+
+            system.compile();
+            assert(physical_of(system, s.color) == 0);
+            assert(physical_of(system, s.bloom) == 1);
+            assert(physical_of(system, s.post) == 2);
+            assert(physical_of(system, s.final_c) == 3);
+            assert(system.physical_resource_metas.image_mapping_changes == 0);
+
+            s.enable_bloom = false;
+            system.compile();
+            assert(physical_of(system, s.post) == 1);
+            assert(physical_of(system, s.final_c) == 2);
+            assert(system.physical_resource_metas.image_mapping_changes == 2);
+            (void)system;
+        }
+
+        // Stable aliasing keeps every surviving mapping.
+        s.reset();
+        render_graph_system system;
+        system.set_stable_aliasing(true);
+        build(system);
+
+        system.compile();
+        const auto bloom_physical = physical_of(system, s.bloom);
+        const auto post_physical  = physical_of(system, s.post);
+        const auto final_physical = physical_of(system, s.final_c);
+
+        s.enable_bloom = false;
+        system.compile();
+        assert(physical_of(system, s.color) == 0);
+        assert(physical_of(system, s.post) == post_physical);
+        assert(physical_of(system, s.final_c) == final_physical);
+        assert(system.physical_resource_metas.image_mapping_changes == 0);
+
+        // The bloom id is left as a hole.
+        assert(system.physical_resource_metas.physical_image_meta.size() == 4);
+        assert(system.physical_resource_metas.physical_image_meta[bloom_physical] == invalid);
+
+        // Re-enabling bloom fills the hole again.
+        s.enable_bloom = true;
+        system.compile();
+        assert(physical_of(system, s.bloom) == bloom_physical);
+        assert(physical_of(system, s.post) == post_physical);
+        assert(physical_of(system, s.final_c) == final_physical);
+        assert(system.physical_resource_metas.image_mapping_changes == 0);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies hint-based aliasing: toggling a pass keeps the physical ids of unrelated resources,
+    // leaving holes that later resources fill, and reports the number of changed mappings.
+    void stable_aliasing_test();
+}
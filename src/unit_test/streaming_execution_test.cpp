@@ -0,0 +1,195 @@
+#include "render_graph/unit_test/streaming_execution_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/recording_backend.h"
+#include "render_graph/system.h"
+#include "render_graph/task_pool.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle depth    = 0;
+            resource_handle color    = 0;
+            resource_handle post     = 0;
+            resource_handle resolved = 0;
+            resource_handle taa      = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: depth prepass.
+        void depth_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.depth = ctx.create_image(color_info("depth"));
+            ctx.write_image(s.depth, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: shading.
+        void color_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.depth, image_usage::SAMPLED);
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: post processing.
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            s.post = ctx.create_image(color_info("post"));
+            ctx.write_image(s.post, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: resolve, a history resource of the next pass (sRGB: not aliased with the images above).
+        void resolve_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.post, image_usage::SAMPLED);
+            s.resolved = ctx.create_image(color_info("resolved", format::R8G8B8A8_SRGB));
+            ctx.write_image(s.resolved, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 4: temporal accumulation with the previous frame's resolve.
+        void taa_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.resolved, image_usage::SAMPLED);
+            ctx.read_image_previous_frame(s.resolved, image_usage::SAMPLED);
+            s.taa = ctx.create_image(color_info("taa", format::R8G8B8A8_SRGB));
+            ctx.write_image(s.taa, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.taa);
+        }
+
+        void build_graph(render_graph_system& system)
+        {
+            system.add_pass(depth_setup, noop_execute);
+            system.add_pass(color_setup, noop_execute);
+            system.add_pass(post_setup, noop_execute);
+            system.add_pass(resolve_setup, noop_execute);
+            system.add_pass(taa_setup, noop_execute);
+        }
+    } // namespace
+
+    void streaming_execution_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        task_pool pool(2);
+
+        recording_backend reference_recorder;
+        render_graph_system reference;
+        reference.set_backend(&reference_recorder);
+        build_graph(reference);
+
+        recording_backend streamed_recorder;
+        render_graph_system streamed;
+        streamed.set_backend(&streamed_recorder);
+        streamed.set_job_system(&pool);
+        build_graph(streamed);
+
+        // Off: compile_and_execute() is compile() + execute().
+        streamed.compile_and_execute();
+        reference.compile();
+        reference.execute();
+        assert(streamed.streamed_passes == 0);
+        assert(streamed_recorder.to_text() == reference_recorder.to_text());
+
+        // The prefix ends before the resolve pass, the first one touching a history id.
+        streamed.set_streaming_execution(8);
+        for (uint32_t frame = 0; frame < 3; frame++)
+        {
+            streamed.compile_and_execute();
+            reference.compile();
+            reference.execute();
+            assert(streamed.streamed_passes == 3);
+            assert(streamed_recorder.stats.frames == reference_recorder.stats.frames);
+            assert(streamed_recorder.to_text() == reference_recorder.to_text());
+        }
+
+        // The limit caps the prefix; without a job system it executes inline.
+        streamed.set_streaming_execution(2);
+        streamed.set_job_system(nullptr);
+        streamed.compile_and_execute();
+        reference.compile();
+        reference.execute();
+        assert(streamed.streamed_passes == 2);
+        assert(streamed_recorder.to_text() == reference_recorder.to_text());
+
+        // Three frames in flight: shared ids get cross-frame barriers from their last use in the schedule, which
+        // the prefix plan includes, so the same prefix streams.
+        streamed.set_job_system(&pool);
+        streamed.set_streaming_execution(8);
+        streamed.set_frames_in_flight(3);
+        reference.set_frames_in_flight(3);
+        for (uint32_t frame = 0; frame < 3; frame++)
+        {
+            streamed.compile_and_execute();
+            reference.compile();
+            reference.execute();
+            assert(streamed.streamed_passes == 3);
+            assert(streamed_recorder.to_text() == reference_recorder.to_text());
+        }
+        const auto first_pass = streamed.sorted_passes[0];
+        assert(streamed.stream_barriers.pass_lengths[first_pass] > 0);
+        assert(streamed.stream_barriers.pass_lengths[first_pass] == reference.per_pass_barriers.pass_lengths[first_pass]);
+
+        // A tracer does not turn streaming off: the prefix still runs as a job and records its spans.
+        trace_recorder recorder;
+        streamed.set_tracer(&recorder);
+        streamed.set_frames_in_flight(1);
+        reference.set_frames_in_flight(1);
+        streamed.compile_and_execute();
+        reference.compile();
+        reference.execute();
+        assert(streamed.streamed_passes == 3);
+        assert(streamed_recorder.to_text() == reference_recorder.to_text());
+        uint32_t execute_spans = 0;
+        for (const auto& e : recorder.events)
+        {
+            execute_spans += e.category == "execute" ? 1U : 0U;
+        }
+        assert(execute_spans == 5);
+        streamed.set_tracer(nullptr);
+
+        // A retained compile without changes returns before Step I and the whole schedule executes afterwards.
+        streamed.set_frames_in_flight(1);
+        reference.set_frames_in_flight(1);
+        streamed.set_retained_mode(true);
+        reference.set_retained_mode(true);
+        streamed.compile_and_execute();
+        reference.compile();
+        reference.execute();
+        assert(streamed.streamed_passes == 3);
+        streamed.compile_and_execute();
+        reference.compile();
+        reference.execute();
+        assert(streamed.streamed_passes == 0);
+        assert(streamed_recorder.stats.frames == reference_recorder.stats.frames);
+        assert(streamed_recorder.to_text() == reference_recorder.to_text());
+
+        (void)streamed;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks that compile_and_execute() streams the final prefix of the schedule (stopping before history ids,
+    // including cross-frame barriers of shared ids) and records the same allocations, passes and barriers as
+    // compile() + execute(), with or without a tracer.
+    void streaming_execution_test();
+}
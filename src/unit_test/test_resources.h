@@ -0,0 +1,41 @@
+#pragma once
+
+#include "render_graph/resource.h"
+
+namespace render_graph::unit_test
+{
+    // Resource descriptions shared by the unit tests.
+
+    // Single-mip 64x64 2D color target.
+    inline image_info color_info(const char* name, image_usage usage = image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED,
+                                 format fmt = format::R8G8B8A8_UNORM)
+    {
+        return image_info{
+            .name          = name,
+            .fmt           = fmt,
+            .extent        = {.width = 64, .height = 64, .depth = 1},
+            .usage         = usage,
+            .type          = image_type::TYPE_2D,
+            .flags         = image_flags::NONE,
+            .mip_levels    = 1,
+            .array_layers  = 1,
+            .sample_counts = 1,
+            .imported      = false,
+        };
+    }
+
+    inline image_info color_info(const char* name, format fmt)
+    {
+        return color_info(name, image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED, fmt);
+    }
+
+    inline buffer_info storage_info(const char* name)
+    {
+        return buffer_info{
+            .name     = name,
+            .size     = 256,
+            .usage    = buffer_usage::STORAGE_BUFFER,
+            .imported = false,
+        };
+    }
+} // namespace render_graph::unit_test
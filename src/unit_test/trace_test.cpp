@@ -0,0 +1,129 @@
+#include "render_graph/unit_test/trace_test.h"
+
+#include <cassert>
+#include <string>
+
+#include "render_graph/system.h"
+#include "render_graph/trace.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle scene   = 0;
+            resource_handle final_c = 0;
+            uint32_t executed       = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        struct null_backend final : backend
+        {
+            void apply_barriers(pass_handle, const per_pass_barrier&) override { }
+        };
+
+        void count_execute(pass_execute_context&) { test_state().executed++; }
+
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.scene = ctx.create_image(color_info("scene \"hdr\""));
+            ctx.write_image(s.scene, image_usage::COLOR_ATTACHMENT);
+        }
+
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.scene, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        const trace_recorder::event* find_event(const trace_recorder& recorder, const std::string& name)
+        {
+            for (const auto& e : recorder.events)
+            {
+                if (e.name == name)
+                {
+                    return &e;
+                }
+            }
+            return nullptr;
+        }
+    } // namespace
+
+    void trace_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        trace_recorder recorder;
+        null_backend backend_impl;
+
+        render_graph_system system;
+        system.set_backend(&backend_impl);
+        const auto scene = system.add_pass("scene", scene_setup, count_execute);
+        const auto post  = system.add_pass(post_setup, count_execute);
+        assert(system.pass_name(scene) == "scene");
+        assert(system.pass_name(post).empty());
+
+        // Without a recorder nothing is traced.
+        system.compile();
+        system.execute();
+        assert(recorder.events.empty());
+
+        system.set_tracer(&recorder);
+        system.mark_all_passes_dirty();
+        system.compile();
+
+        // One span per compile step, back to back.
+        const char* steps[] = {"setup", "versioning", "producer map", "culling", "validation", "dag", "scheduling", "lifetimes & aliasing", "barriers", "allocation"};
+        assert(recorder.events.size() == std::size(steps));
+        for (size_t i = 0; i < std::size(steps); i++)
+        {
+            const auto& e = recorder.events[i];
+            assert(e.name == steps[i] && e.category == "compile" && e.track == trace_recorder::cpu_track);
+            assert(e.duration_us >= 0.0);
+            assert(i == 0 || e.begin_us >= recorder.events[i - 1].begin_us + recorder.events[i - 1].duration_us - 0.001);
+        }
+
+        recorder.clear();
+        system.execute();
+        assert(s.executed == 4);
+
+        // Barrier and execute spans per pass; unnamed passes are labeled by handle.
+        assert(recorder.events.size() == 4);
+        const auto* scene_exec    = find_event(recorder, "scene");
+        const auto* post_barriers = find_event(recorder, "pass 1 barriers");
+        const auto* post_exec     = find_event(recorder, "pass 1");
+        assert(scene_exec != nullptr && scene_exec->category == "execute");
+        assert(post_barriers != nullptr && post_barriers->category == "barriers");
+        assert(post_exec != nullptr && post_exec->begin_us >= post_barriers->begin_us);
+
+        // The sampled scene image transitions before the post pass and is listed by name.
+        assert(post_barriers->args.find("\"resources\":[") != std::string::npos);
+        assert(post_barriers->args.find("scene \\\"hdr\\\"") != std::string::npos);
+
+        recorder.gpu_span("scene", 10.0, 2.5);
+        const auto json = recorder.to_chrome_json();
+        assert(json.front() == '{' && json.back() == '}');
+        assert(json.find("\"traceEvents\":[") != std::string::npos);
+        assert(json.find("\"name\":\"pass 1 barriers\",\"cat\":\"barriers\",\"ph\":\"X\"") != std::string::npos);
+        assert(json.find("\"ts\":10.000,\"dur\":2.500,\"pid\":1,\"tid\":2") != std::string::npos);
+
+        (void)post;
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Checks compile step spans, per-pass barrier/execute spans with pass and resource
+    // names, and the Chrome trace JSON export.
+    void trace_test();
+}
@@ -0,0 +1,187 @@
+#include "render_graph/unit_test/transient_attachment_test.h"
+
+#include <cassert>
+
+#include "render_graph/system.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            resource_handle msaa_color    = 0;
+            resource_handle msaa_depth    = 0;
+            resource_handle scene_depth   = 0;
+            resource_handle shadow_depth  = 0;
+            resource_handle resolved      = 0;
+            resource_handle final_color   = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: shadow map (depth attachment that is later sampled -> must stay in memory).
+        void shadow_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.shadow_depth = ctx.create_image(image_info{
+                .name          = "shadow_depth",
+                .fmt           = format::D32_SFLOAT,
+                .extent        = {.width = 1024, .height = 1024, .depth = 1},
+                .usage         = image_usage::DEPTH_STENCIL_ATTACHMENT | image_usage::SAMPLED,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            ctx.write_image(s.shadow_depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+        }
+
+        // Pass 1: MSAA scene resolved within the pass; the MSAA color + depth are only used as attachments of
+        // this pass. The single-sampled scene depth is kept for the overlay pass.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.shadow_depth, image_usage::SAMPLED);
+
+            s.msaa_color = ctx.create_image(image_info{
+                .name          = "msaa_color",
+                .fmt           = format::R8G8B8A8_UNORM,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::COLOR_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 4,
+                .imported      = false,
+            });
+            s.msaa_depth = ctx.create_image(image_info{
+                .name          = "msaa_depth",
+                .fmt           = format::D32_SFLOAT,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::DEPTH_STENCIL_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 4,
+                .imported      = false,
+            });
+            s.scene_depth = ctx.create_image(image_info{
+                .name          = "scene_depth",
+                .fmt           = format::D32_SFLOAT,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::DEPTH_STENCIL_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            s.resolved = ctx.create_image(image_info{
+                .name          = "resolved",
+                .fmt           = format::R8G8B8A8_UNORM,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::COLOR_ATTACHMENT | image_usage::SAMPLED,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            ctx.write_image(s.msaa_color, image_usage::COLOR_ATTACHMENT);
+            ctx.write_image(s.msaa_depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+            ctx.write_image(s.scene_depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+            ctx.write_image(s.resolved, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: overlay depth-tested against the scene depth, blended into the resolved image. The scene depth is
+        // attachment-only but crosses a pass boundary (stored, then loaded) -> backed by memory.
+        void overlay_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.scene_depth, image_usage::DEPTH_STENCIL_ATTACHMENT);
+            ctx.read_image(s.resolved, image_usage::COLOR_ATTACHMENT);
+            ctx.write_image(s.resolved, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: post-process samples the resolved image and writes the declared output.
+        void post_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.resolved, image_usage::SAMPLED);
+
+            s.final_color = ctx.create_image(image_info{
+                .name          = "final_color",
+                .fmt           = format::R8G8B8A8_UNORM,
+                .extent        = {.width = 1280, .height = 720, .depth = 1},
+                .usage         = image_usage::COLOR_ATTACHMENT,
+                .type          = image_type::TYPE_2D,
+                .flags         = image_flags::NONE,
+                .mip_levels    = 1,
+                .array_layers  = 1,
+                .sample_counts = 1,
+                .imported      = false,
+            });
+            ctx.write_image(s.final_color, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_color);
+        }
+
+        bool is_memoryless(const render_graph_system& system, resource_handle logical)
+        {
+            const auto& physical_metas = system.physical_resource_metas;
+            assert(logical < physical_metas.handle_to_physical_img_id.size());
+            const auto physical = physical_metas.handle_to_physical_img_id[logical];
+            assert(physical < physical_metas.physical_image_memoryless.size());
+            return physical_metas.physical_image_memoryless[physical];
+        }
+    } // namespace
+
+    void transient_attachment_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.add_pass(shadow_setup, noop_execute);  // 0
+        system.add_pass(scene_setup, noop_execute);   // 1
+        system.add_pass(overlay_setup, noop_execute); // 2
+        system.add_pass(post_setup, noop_execute);    // 3
+
+        system.compile();
+
+        assert(system.physical_resource_metas.physical_image_memoryless.size() ==
+               system.physical_resource_metas.physical_image_meta.size());
+
+        // MSAA color/depth never leave the scene pass -> memoryless.
+        assert(is_memoryless(system, s.msaa_color));
+        assert(is_memoryless(system, s.msaa_depth));
+
+        // Attachment-only, but loaded by a later pass.
+        assert(!is_memoryless(system, s.scene_depth));
+
+        // Depth that is later sampled, a sampled resolve target, and the declared output must be backed by memory.
+        assert(!is_memoryless(system, s.shadow_depth));
+        assert(!is_memoryless(system, s.resolved));
+        assert(!is_memoryless(system, s.final_color));
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Builds an MSAA scene pass (color + depth used only as attachments) resolved into a sampled image
+    // within the pass, plus a depth attachment loaded by a later pass, and validates which physical images
+    // are classified as memoryless.
+    void transient_attachment_test();
+}
@@ -0,0 +1,152 @@
+#include "render_graph/unit_test/transitive_reduction_test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        constexpr uint32_t chain_length = 100;
+
+        struct test_state_t
+        {
+            resource_handle depth   = 0;
+            resource_handle gbuffer = 0;
+            resource_handle light   = 0;
+            resource_handle final_c = 0;
+
+            std::vector<resource_handle> layers;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: depth prepass.
+        void depth_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            s.depth = ctx.create_image(color_info("depth"));
+            ctx.write_image(s.depth, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: gbuffer reads depth.
+        void gbuffer_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.depth, image_usage::SAMPLED);
+            s.gbuffer = ctx.create_image(color_info("gbuffer"));
+            ctx.write_image(s.gbuffer, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 2: lighting reads depth (implied by gbuffer) and gbuffer.
+        void lighting_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.depth, image_usage::SAMPLED);
+            ctx.read_image(s.gbuffer, image_usage::SAMPLED);
+            s.light = ctx.create_image(color_info("light"));
+            ctx.write_image(s.light, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 3: composite reads depth (implied) and lighting.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            ctx.read_image(s.depth, image_usage::SAMPLED);
+            ctx.read_image(s.light, image_usage::SAMPLED);
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        // Every layer reads all previous layers: n(n-1)/2 edges, n-1 of them necessary.
+        void layer_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+
+            for (const auto layer : s.layers)
+            {
+                ctx.read_image(layer, image_usage::SAMPLED);
+            }
+            const auto layer = ctx.create_image(color_info("layer"));
+            ctx.write_image(layer, image_usage::COLOR_ATTACHMENT);
+            s.layers.push_back(layer);
+            if (s.layers.size() == chain_length)
+            {
+                ctx.declare_image_output(layer);
+            }
+        }
+
+        std::vector<pass_handle> successors(const std::vector<pass_handle>& list, const std::vector<uint32_t>& begins, pass_handle pass)
+        {
+            return std::vector<pass_handle>(list.begin() + begins[pass], list.begin() + begins[pass + 1]);
+        }
+    } // namespace
+
+    void transitive_reduction_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.add_pass(depth_setup, noop_execute);     // 0
+        system.add_pass(gbuffer_setup, noop_execute);   // 1
+        system.add_pass(lighting_setup, noop_execute);  // 2
+        system.add_pass(composite_setup, noop_execute); // 3
+
+        // Disabled by default.
+        system.compile();
+        assert(system.dag.reduced_adjacency_list.empty());
+        assert(system.dag.adjacency_list.size() == 5);
+
+        system.set_transitive_reduction(true);
+        s.reset();
+        system.compile();
+
+        const auto& dag = system.dag;
+        assert(dag.adjacency_list.size() == 5);
+        assert(dag.reduced_adjacency_list.size() == 3);
+        assert((successors(dag.reduced_adjacency_list, dag.reduced_adjacency_begins, 0) == std::vector<pass_handle>{1}));
+        assert((successors(dag.reduced_adjacency_list, dag.reduced_adjacency_begins, 1) == std::vector<pass_handle>{2}));
+        assert((successors(dag.reduced_adjacency_list, dag.reduced_adjacency_begins, 2) == std::vector<pass_handle>{3}));
+        assert(successors(dag.reduced_adjacency_list, dag.reduced_adjacency_begins, 3).empty());
+        assert((dag.reduced_in_degrees == std::vector<uint32_t>{0, 1, 1, 1}));
+        assert((dag.in_degrees == std::vector<uint32_t>{0, 1, 2, 2}));
+
+        // Dense chain.
+        s.reset();
+        render_graph_system chain;
+        chain.set_transitive_reduction(true);
+        for (uint32_t i = 0; i < chain_length; i++)
+        {
+            chain.add_pass(layer_setup, noop_execute);
+        }
+        chain.compile();
+
+        assert(chain.dag.adjacency_list.size() == chain_length * (chain_length - 1) / 2);
+        assert(chain.dag.reduced_adjacency_list.size() == chain_length - 1);
+        for (pass_handle pass = 0; pass + 1 < chain_length; pass++)
+        {
+            assert((successors(chain.dag.reduced_adjacency_list, chain.dag.reduced_adjacency_begins, pass) == std::vector<pass_handle>{pass + 1}));
+        }
+
+        (void)system;
+        (void)chain;
+    }
+} // namespace render_graph::unit_test
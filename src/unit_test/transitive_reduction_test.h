@@ -0,0 +1,7 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Transitive reduction: redundant producer->consumer edges are dropped, reachability and the full DAG are kept.
+    void transitive_reduction_test();
+}
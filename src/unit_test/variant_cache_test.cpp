@@ -0,0 +1,171 @@
+#include "render_graph/unit_test/variant_cache_test.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "render_graph/system.h"
+#include "render_graph/unit_test/test_resources.h"
+
+namespace render_graph::unit_test
+{
+    namespace
+    {
+        struct test_state_t
+        {
+            bool enable_bloom = true;
+            bool enable_ssao  = false;
+
+            uint32_t setup_calls = 0;
+
+            resource_handle color   = 0;
+            resource_handle bloom   = 0;
+            resource_handle ssao    = 0;
+            resource_handle final_c = 0;
+
+            void reset() { *this = test_state_t{}; }
+        };
+
+        test_state_t& test_state()
+        {
+            static test_state_t state{};
+            return state;
+        }
+
+        void noop_execute(pass_execute_context&) { }
+
+        // Pass 0: scene color.
+        void scene_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.setup_calls++;
+
+            s.color = ctx.create_image(color_info("color"));
+            ctx.write_image(s.color, image_usage::COLOR_ATTACHMENT);
+        }
+
+        // Pass 1: optional effects toggled by quality flags.
+        void effects_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.setup_calls++;
+
+            if (s.enable_bloom)
+            {
+                ctx.read_image(s.color, image_usage::SAMPLED);
+                s.bloom = ctx.create_image(color_info("bloom"));
+                ctx.write_image(s.bloom, image_usage::COLOR_ATTACHMENT);
+            }
+            if (s.enable_ssao)
+            {
+                ctx.read_image(s.color, image_usage::SAMPLED);
+                s.ssao = ctx.create_image(color_info("ssao"));
+                ctx.write_image(s.ssao, image_usage::COLOR_ATTACHMENT);
+            }
+        }
+
+        // Pass 2: composite into the declared output.
+        void composite_setup(pass_setup_context& ctx)
+        {
+            auto& s = test_state();
+            s.setup_calls++;
+
+            ctx.read_image(s.color, image_usage::SAMPLED);
+            if (s.enable_bloom)
+            {
+                ctx.read_image(s.bloom, image_usage::SAMPLED);
+            }
+            if (s.enable_ssao)
+            {
+                ctx.read_image(s.ssao, image_usage::SAMPLED);
+            }
+            s.final_c = ctx.create_image(color_info("final"));
+            ctx.write_image(s.final_c, image_usage::COLOR_ATTACHMENT);
+            ctx.declare_image_output(s.final_c);
+        }
+
+        void extra_setup(pass_setup_context&) { }
+
+        uint64_t variant_of(const test_state_t& s)
+        {
+            return (s.enable_bloom ? 1ULL : 0ULL) | (s.enable_ssao ? 2ULL : 0ULL);
+        }
+    } // namespace
+
+    void variant_cache_test()
+    {
+        auto& s = test_state();
+        s.reset();
+
+        render_graph_system system;
+        system.set_variant_cache_capacity(2);
+        system.add_pass(scene_setup, noop_execute);     // 0
+        system.add_pass(effects_setup, noop_execute);   // 1
+        system.add_pass(composite_setup, noop_execute); // 2
+
+        // Variant "bloom": miss, compiled.
+        system.compile_variant(variant_of(s));
+        assert(s.setup_calls == 3);
+        assert(system.variant_cache.misses == 1);
+        const auto bloom_sorted      = system.sorted_passes;
+        const auto bloom_barriers    = system.per_pass_barriers.types.size();
+        const auto bloom_final       = system.physical_resource_metas.handle_to_physical_img_id[s.final_c];
+        const auto bloom_image_count = system.meta_table.image_metas.names.size();
+
+        // Variant "ssao": miss, compiled; the bloom handle is recycled for ssao.
+        s.enable_bloom = false;
+        s.enable_ssao  = true;
+        system.compile_variant(variant_of(s));
+        assert(s.setup_calls == 6);
+        assert(system.variant_cache.misses == 2);
+        assert(!system.meta_table.image_registry.is_alive(s.bloom) || s.ssao == s.bloom);
+
+        // Back to "bloom": hit, setup is skipped and the plan (with its resource tables) is restored.
+        s.enable_bloom = true;
+        s.enable_ssao  = false;
+        system.compile_variant(variant_of(s));
+        assert(s.setup_calls == 6);
+        assert(system.variant_cache.hits == 1);
+        assert(system.sorted_passes == bloom_sorted);
+        assert(system.per_pass_barriers.types.size() == bloom_barriers);
+        assert(system.meta_table.image_metas.names.size() == bloom_image_count);
+        assert(system.meta_table.image_metas.names[s.bloom] == "bloom");
+        assert(system.physical_resource_metas.handle_to_physical_img_id[s.final_c] == bloom_final);
+
+        // A third variant evicts the least recently used one ("ssao").
+        s.enable_bloom = true;
+        s.enable_ssao  = true;
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.entries.size() == 2);
+        s.enable_bloom = false;
+        s.enable_ssao  = true;
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.misses == 4);
+
+        // Toggling a pass with set_pass_enabled() keeps both shapes cached: switching back hits without setup.
+        s.enable_bloom = false;
+        s.enable_ssao  = false;
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.misses == 5);
+        system.set_pass_enabled(1, false);
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.misses == 6);
+        const auto toggled_setup_calls = s.setup_calls;
+        system.set_pass_enabled(1, true);
+        system.compile_variant(variant_of(s));
+        system.set_pass_enabled(1, false);
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.hits == 3);
+        assert(system.variant_cache.misses == 6);
+        assert(s.setup_calls == toggled_setup_calls);
+
+        // Adding a pass changes the structure: cached plans can no longer match and are dropped.
+        system.add_pass(extra_setup, noop_execute);
+        assert(system.variant_cache.entries.empty());
+        system.compile_variant(variant_of(s));
+        assert(system.variant_cache.misses == 7);
+        assert(system.variant_cache.entries.size() == 1);
+        assert(system.last_setup_invocations > 0);
+
+        (void)system;
+    }
+} // namespace render_graph::unit_test
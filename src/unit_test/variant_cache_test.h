@@ -0,0 +1,8 @@
+#pragma once
+
+namespace render_graph::unit_test
+{
+    // Verifies the compiled-plan variant cache: hits skip setup and restore the plan,
+    // LRU eviction, hits across set_pass_enabled() toggles, and invalidation on structural changes.
+    void variant_cache_test();
+}